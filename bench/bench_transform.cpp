@@ -0,0 +1,668 @@
+//
+// Created by taylor-santos on 10/16/2026 at 20:31.
+//
+
+#include "camera.h"
+#include "frustum.h"
+#include "occlusion_buffer.h"
+#include "thread_pool.h"
+#include "transform.h"
+#include "transform_bake.h"
+#include "transform_journal.h"
+#include "transform_pool.h"
+#include "transform_snapshot.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "glm/gtc/type_ptr.hpp"
+
+// Every allocation made through the global operator new, from any thread.
+static std::atomic<std::size_t> allocations{0};
+
+void *
+operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto *ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+// g++ can't tell that these replace the default operator delete, and warns that memory from
+// operator new is being passed to free() once they are inlined into the standard containers.
+#if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void
+operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#endif
+
+struct Result {
+    std::string name;
+    double      nsPerOp;
+    double      allocsPerOp;
+};
+
+static std::vector<Result> results;
+
+// Run fn() `runs` times and record the fastest run, divided by the number of operations that each
+// run performs. Allocations are averaged over every run.
+static void
+benchmark(
+    const std::string           &name,
+    int                          runs,
+    std::size_t                  opsPerRun,
+    const std::function<void()> &fn) {
+    using namespace std::chrono;
+    auto best       = nanoseconds::max();
+    auto allocStart = allocations.load();
+    for (int i = 0; i < runs; i++) {
+        auto start = steady_clock::now();
+        fn();
+        auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start);
+        if (elapsed < best) best = elapsed;
+    }
+    auto ops         = static_cast<double>(opsPerRun);
+    auto nsPerOp     = static_cast<double>(best.count()) / ops;
+    auto allocsPerOp = static_cast<double>(allocations.load() - allocStart) / (ops * runs);
+    results.push_back({name, nsPerOp, allocsPerOp});
+    std::fprintf(
+        stderr,
+        "%-36s %12.2f ns/op %10.4f allocs/op\n",
+        name.c_str(),
+        nsPerOp,
+        allocsPerOp);
+}
+
+// Give the compiler a reason to compute a result that is otherwise never read.
+static volatile double sink;
+
+static void
+keep(double value) {
+    sink = value;
+}
+
+// Build a hierarchy of `count` nodes where each node's parent is a random earlier node. Every
+// parent therefore has a lower index than its children.
+static std::vector<Transform>
+randomTree(std::size_t count) {
+    std::mt19937           rng{12345};
+    std::vector<Transform> nodes;
+    nodes.reserve(count);
+    nodes.emplace_back();
+    for (std::size_t i = 1; i < count; i++) {
+        std::uniform_int_distribution<std::size_t> dist{0, i - 1};
+        nodes.emplace_back(
+            Transform::Builder().withPosition({1, 0, 0}).withParent(nodes[dist(rng)]));
+    }
+    return nodes;
+}
+
+// Build the same hierarchy as randomTree(), but in a pool, returning a Handle to each node.
+static std::vector<TransformPool::Handle>
+randomPoolTree(TransformPool &pool, std::size_t count) {
+    std::mt19937                       rng{12345};
+    std::vector<TransformPool::Handle> handles{pool.create()};
+    for (std::size_t i = 1; i < count; i++) {
+        std::uniform_int_distribution<std::size_t> dist{0, i - 1};
+        auto &parent = pool.get(handles[dist(rng)]);
+        handles.push_back(
+            pool.create(Transform::Builder().withPosition({1, 0, 0}).withParent(parent)));
+    }
+    return handles;
+}
+
+// Build a chain of `depth` nodes where each node is the child of the one before it.
+static std::vector<Transform>
+chain(std::size_t depth) {
+    std::vector<Transform> nodes;
+    nodes.reserve(depth);
+    nodes.emplace_back();
+    for (std::size_t i = 1; i < depth; i++) {
+        nodes.emplace_back(Transform::Builder()
+                               .withPosition({1, 0, 0})
+                               .withRotation(glm::angleAxis(0.01, glm::dvec3{0, 0, 1}))
+                               .withParent(nodes.back()));
+    }
+    return nodes;
+}
+
+// Tear down a hierarchy leaves-first, so that no node has to be reparented on destruction.
+static void
+teardown(std::vector<Transform> &nodes) {
+    while (!nodes.empty()) {
+        nodes.pop_back();
+    }
+}
+
+// Generate `count` random local properties, shared by the decompose and recompose benchmarks.
+static std::vector<Transform::Properties>
+randomProperties(std::size_t count) {
+    std::mt19937                           rng{12345};
+    std::uniform_real_distribution<double> dist{-1, 1};
+    std::vector<Transform::Properties>     props(count);
+    for (auto &p : props) {
+        p.translation = {dist(rng), dist(rng), dist(rng)};
+        p.rotation    = glm::normalize(glm::dquat{dist(rng), dist(rng), dist(rng), dist(rng)});
+        p.scale       = {dist(rng) + 2, dist(rng) + 2, dist(rng) + 2};
+        p.skew        = {dist(rng) / 2, dist(rng) / 2, dist(rng) / 2};
+    }
+    return props;
+}
+
+static constexpr std::size_t NODES        = 100000;
+static constexpr std::size_t CHAIN_DEPTH  = 1000;
+static constexpr std::size_t CHAIN_READS  = 1000;
+static constexpr std::size_t GETTER_DEPTH = 8;
+static constexpr std::size_t GETTER_CALLS = 100000;
+static constexpr std::size_t SETTER_CALLS = 100000;
+static constexpr std::size_t MOVED_NODES  = 1000;
+static constexpr std::size_t FIRST_READS  = 10000;
+static constexpr std::size_t ROOMS        = 1000;
+static constexpr std::size_t WALLS        = 40;
+
+static void
+benchmarkConstruction() {
+    benchmark("Build/RandomTree", 10, NODES, [] {
+        auto nodes = randomTree(NODES);
+        teardown(nodes);
+    });
+    // Unlike a std::vector that hasn't reserved, a pool never moves its Transforms as it grows.
+    benchmark("Build/RandomTree/Pool", 10, NODES, [] {
+        TransformPool pool;
+        (void)randomPoolTree(pool, NODES);
+    });
+    // Destroying parents before their children reparents every child on the way, which
+    // destroySubtree() avoids.
+    benchmark("BuildAndDestroy/Pool/ParentsFirst", 10, NODES, [] {
+        TransformPool pool;
+        for (auto handle : randomPoolTree(pool, NODES)) {
+            pool.destroy(handle);
+        }
+    });
+    benchmark("BuildAndDestroy/Pool/Subtree", 10, NODES, [] {
+        TransformPool pool;
+        pool.destroySubtree(randomPoolTree(pool, NODES).front());
+    });
+    benchmark("Build/Chain", 10, NODES, [] {
+        auto nodes = chain(NODES);
+        teardown(nodes);
+    });
+    benchmark("Build/FanOut", 10, NODES, [] {
+        Transform              root;
+        std::vector<Transform> children;
+        children.reserve(NODES);
+        for (std::size_t i = 0; i < NODES; i++) {
+            children.emplace_back(Transform::Builder().withParent(root));
+        }
+    });
+}
+
+// Read the leaf of a deep chain, and every child of a wide fan-out, after their root has moved
+// (cold) and again once their caches are populated (warm).
+static void
+benchmarkShapes() {
+    auto   nodes = chain(CHAIN_DEPTH);
+    double x     = 0;
+    benchmark("Chain/LeafToWorld/Cold", 10, CHAIN_READS, [&] {
+        for (std::size_t i = 0; i < CHAIN_READS; i++) {
+            nodes.front().setLocalPosition({x++, 0, 0});
+            keep(nodes.back().localToWorldMatrix()[3][0]);
+        }
+    });
+    benchmark("Chain/LeafToWorld/Warm", 10, CHAIN_READS, [&] {
+        for (std::size_t i = 0; i < CHAIN_READS; i++) {
+            keep(nodes.back().localToWorldMatrix()[3][0]);
+        }
+    });
+    teardown(nodes);
+
+    Transform              root;
+    std::vector<Transform> children;
+    children.reserve(NODES);
+    for (std::size_t i = 0; i < NODES; i++) {
+        children.emplace_back(
+            Transform::Builder().withPosition({static_cast<double>(i), 0, 0}).withParent(root));
+    }
+    benchmark("FanOut/ChildToWorld/Cold", 10, NODES, [&] {
+        root.setLocalPosition({x++, 0, 0});
+        for (auto &child : children) {
+            keep(child.localToWorldMatrix()[3][0]);
+        }
+    });
+    benchmark("FanOut/ChildToWorld/Warm", 10, NODES, [&] {
+        for (auto &child : children) {
+            keep(child.localToWorldMatrix()[3][0]);
+        }
+    });
+}
+
+// Move random nodes beneath random new parents. Each new parent has a lower index than the node it
+// adopts, which keeps the tree free of cycles.
+static void
+benchmarkReparent() {
+    for (bool preserveLocalSpace : {true, false}) {
+        auto         nodes = randomTree(NODES);
+        std::mt19937 rng{12345};
+        auto name = std::string("Reparent/") + (preserveLocalSpace ? "KeepLocal" : "KeepWorld");
+        benchmark(name, 10, NODES, [&] {
+            for (std::size_t i = 0; i < NODES; i++) {
+                std::uniform_int_distribution<std::size_t> childDist{1, NODES - 1};
+                auto                                       child = childDist(rng);
+                std::uniform_int_distribution<std::size_t> parentDist{0, child - 1};
+                nodes[child].setParent(&nodes[parentDist(rng)], preserveLocalSpace);
+            }
+        });
+        teardown(nodes);
+    }
+
+    // The same changes as Reparent/KeepWorld, but committed together.
+    auto         nodes = randomTree(NODES);
+    std::mt19937 rng{12345};
+    benchmark("Reparent/KeepWorld/Edit", 10, NODES, [&] {
+        Transform::Edit edit;
+        for (std::size_t i = 0; i < NODES; i++) {
+            std::uniform_int_distribution<std::size_t> childDist{1, NODES - 1};
+            auto                                       child = childDist(rng);
+            std::uniform_int_distribution<std::size_t> parentDist{0, child - 1};
+            edit.setParent(nodes[child], &nodes[parentDist(rng)]);
+        }
+        edit.commit();
+    });
+    teardown(nodes);
+}
+
+// Call a world-space getter on the leaf of a short chain after its root has rotated (cold) and
+// again once its caches are populated (warm).
+template<typename Getter>
+static void
+benchmarkGetter(const std::string &name, Getter getter) {
+    auto   nodes = chain(GETTER_DEPTH);
+    auto  &leaf  = nodes.back();
+    double angle = 0;
+    benchmark(name + "/Cold", 10, GETTER_CALLS, [&] {
+        for (std::size_t i = 0; i < GETTER_CALLS; i++) {
+            nodes.front().setLocalRotation(glm::angleAxis(angle += 0.001, glm::dvec3{0, 1, 0}));
+            keep(getter(leaf));
+        }
+    });
+    benchmark(name + "/Warm", 10, GETTER_CALLS, [&] {
+        for (std::size_t i = 0; i < GETTER_CALLS; i++) {
+            keep(getter(leaf));
+        }
+    });
+    teardown(nodes);
+}
+
+// Call a world-space setter SETTER_CALLS times on a child of the given parent, or on a root if
+// parent is nullptr, with a different value each time.
+template<typename Setter>
+static void
+benchmarkSetter(const std::string &name, Transform *parent, Setter setter) {
+    Transform child = Transform::Builder().withPosition({1, 2, 3}).withScale({2, 1, 3});
+    child.setParent(parent, true);
+    benchmark(name, 10, SETTER_CALLS, [&] {
+        for (std::size_t i = 0; i < SETTER_CALLS; i++) {
+            setter(child, static_cast<double>(i % 64) / 64);
+        }
+    });
+}
+
+static void
+benchmarkAccessors() {
+    benchmarkGetter("Get/Position", [](const Transform &t) { return t.position().x; });
+    benchmarkGetter("Get/Rotation", [](const Transform &t) { return t.rotation().w; });
+    benchmarkGetter("Get/Scale", [](const Transform &t) { return t.scale().x; });
+    benchmarkGetter("Get/LocalToWorld", [](const Transform &t) {
+        return t.localToWorldMatrix()[3][0];
+    });
+    benchmarkGetter("Get/WorldToLocal", [](const Transform &t) {
+        return t.worldToLocalMatrix()[3][0];
+    });
+
+    // Setters take analytic shortcuts beneath no parent or a similarity (uniform scale, no skew)
+    // parent, but must decompose matrices beneath a skewed one.
+    Transform similar = Transform::Builder()
+                            .withRotation(glm::angleAxis(1.0, glm::dvec3{0, 1, 0}))
+                            .withScale({2, 2, 2});
+    Transform skewed  = Transform::Builder().withScale({1, 2, 3}).withSkew({0.2, 0, 0});
+    std::pair<const char *, Transform *> parents[] = {
+        {"Root", nullptr},
+        {"SimilarParent", &similar},
+        {"SkewedParent", &skewed}};
+    for (auto [parentName, parent] : parents) {
+        auto suffix = std::string("/") + parentName;
+        benchmarkSetter("SetPosition" + suffix, parent, [](Transform &t, double x) {
+            t.setPosition({x, 1, 2});
+        });
+        benchmarkSetter("SetRotation" + suffix, parent, [](Transform &t, double x) {
+            t.setRotation(glm::angleAxis(x, glm::dvec3{0, 0, 1}));
+        });
+        benchmarkSetter("SetScale" + suffix, parent, [](Transform &t, double x) {
+            t.setScale({1 + x, 1, 2});
+        });
+        benchmarkSetter("SetSkew" + suffix, parent, [](Transform &t, double x) {
+            t.setSkew({x, 0, 0});
+        });
+    }
+}
+
+static void
+benchmarkBatches() {
+    auto                    props = randomProperties(NODES);
+    std::vector<glm::dmat4> mats(NODES);
+    Transform::recompose(props, mats);
+    benchmark("Recompose/Scalar", 10, NODES, [&] {
+        for (std::size_t i = 0; i < NODES; i++) mats[i] = Transform::recompose(props[i]);
+    });
+    benchmark("Recompose/Batch", 10, NODES, [&] { Transform::recompose(props, mats); });
+    benchmark("Decompose/Scalar", 10, NODES, [&] {
+        for (std::size_t i = 0; i < NODES; i++) props[i] = Transform::decompose(mats[i]);
+    });
+    benchmark("Decompose/Batch", 10, NODES, [&] { Transform::decompose(mats, props); });
+
+    // Push points through a Transform one at a time through the matrix getter, or all at once.
+    Transform mover = Transform::Builder().withPosition({1, 2, 3}).withScale({2, 2, 2});
+    std::vector<glm::dvec3> points(NODES, glm::dvec3{1, 2, 3});
+    benchmark("TransformPoints/Scalar", 10, NODES, [&] {
+        for (auto &point : points) {
+            point = glm::dvec3(mover.localToWorldMatrix() * glm::dvec4(point, 1));
+        }
+    });
+    benchmark("TransformPoints/Batch", 10, NODES, [&] { mover.transformPoints(points, points); });
+
+    // Move the root of a random hierarchy, then bring every world matrix up to date.
+    auto   nodes = randomTree(NODES);
+    double x     = 0;
+    benchmark("UpdateWorldMatrices/Serial", 10, NODES, [&] {
+        nodes.front().setLocalPosition({x++, 0, 0});
+        nodes.front().updateWorldMatrices();
+    });
+    ThreadPool pool;
+    benchmark("UpdateWorldMatrices/Parallel", 10, NODES, [&] {
+        nodes.front().setLocalPosition({x++, 0, 0});
+        nodes.front().updateWorldMatrices(pool);
+    });
+
+    // Move scattered nodes of a fully tracked hierarchy, then collect the IDs of every node that
+    // moved with them, as a renderer would before uploading only those matrices.
+    {
+        TransformJournal journal;
+        for (std::size_t i = 0; i < NODES; i++) {
+            journal.track(nodes[i], static_cast<TransformJournal::Id>(i));
+        }
+        (void)journal.flush();
+        benchmark("Journal/Flush", 10, MOVED_NODES, [&] {
+            for (std::size_t i = 0; i < MOVED_NODES; i++) {
+                nodes[NODES - 1 - i * (NODES / MOVED_NODES)].setLocalPosition({x++, 0, 0});
+            }
+            keep(static_cast<double>(journal.flush().size()));
+        });
+    }
+
+    // Move the root, then copy every world matrix into a snapshot for another thread to read.
+    TransformSnapshots snapshots;
+    benchmark("Snapshot/Publish", 10, NODES, [&] {
+        nodes.front().setLocalPosition({x++, 0, 0});
+        snapshots.publish(nodes.front());
+    });
+
+    // Narrow every world matrix for upload, one glm conversion at a time or packed with SIMD.
+    std::vector<const Transform *> pointers;
+    for (auto &node : nodes) pointers.push_back(&node);
+    std::vector<glm::mat4> staging(NODES);
+    auto                   floats = std::span(glm::value_ptr(staging[0]), 16 * NODES);
+    benchmark("ExportWorldMatrices/Scalar", 10, NODES, [&] {
+        for (std::size_t i = 0; i < NODES; i++) {
+            staging[i] = glm::mat4(nodes[i].localToWorldMatrix());
+        }
+    });
+    benchmark("ExportWorldMatrices/Batch", 10, NODES, [&] {
+        Transform::exportWorldMatrices(pointers, floats);
+    });
+    // The same, but from matrices that are already contiguous, such as a bake or a snapshot.
+    std::vector<glm::dmat4> worlds;
+    for (auto &node : nodes) worlds.push_back(node.localToWorldMatrix());
+    benchmark("ExportMatrices/Scalar", 10, NODES, [&] {
+        for (std::size_t i = 0; i < NODES; i++) staging[i] = glm::mat4(worlds[i]);
+    });
+    benchmark("ExportMatrices/Batch", 10, NODES, [&] {
+        Transform::exportMatrices(worlds, floats);
+    });
+
+    // Visit every node of the hierarchy depth-first through the child links, reading only local
+    // data, as tools and scene traversals do. This only touches the hot part of each Transform.
+    std::vector<const Transform *> stack;
+    benchmark("Walk/Hierarchy", 10, NODES, [&] {
+        double sum = 0;
+        stack.assign(1, &nodes.front());
+        while (!stack.empty()) {
+            auto *node = stack.back();
+            stack.pop_back();
+            sum += node->localPosition().x;
+            for (auto *child = node->firstChild(); child; child = child->nextSibling()) {
+                stack.push_back(child);
+            }
+        }
+        keep(sum);
+    });
+
+    // Read every world matrix of a freshly built hierarchy, where each read allocates the node's
+    // cache, then again after its root has moved, where the caches are only refilled. The
+    // difference between them is the cost of allocating the caches lazily. Each run needs its own
+    // fresh hierarchy, so they are all built up front.
+    {
+        std::vector<std::vector<Transform>> trees;
+        for (int i = 0; i < 10; i++) trees.push_back(randomTree(FIRST_READS));
+        std::size_t run = 0;
+        benchmark("Get/FirstRead", 10, FIRST_READS, [&] {
+            double sum = 0;
+            for (auto &node : trees[run++]) sum += node.localToWorldMatrix()[3][0];
+            keep(sum);
+        });
+        auto &tree = trees.back();
+        benchmark("Get/Reread", 10, FIRST_READS, [&] {
+            tree.front().setLocalPosition({x++, 0, 0});
+            double sum = 0;
+            for (auto &node : tree) sum += node.localToWorldMatrix()[3][0];
+            keep(sum);
+        });
+        for (auto &fresh : trees) teardown(fresh);
+    }
+
+    // Read every world matrix of a static hierarchy, through the getters or straight from a bake.
+    {
+        auto baked = nodes.front().bake();
+        benchmark("ReadWorldMatrices/Getter", 10, NODES, [&] {
+            double sum = 0;
+            for (auto &node : nodes) sum += node.localToWorldMatrix()[3][0];
+            keep(sum);
+        });
+        benchmark("ReadWorldMatrices/Baked", 10, NODES, [&] {
+            double sum = 0;
+            for (auto &mat : baked.matrices()) sum += mat[3][0];
+            keep(sum);
+        });
+    }
+    teardown(nodes);
+}
+
+static void
+benchmarkCulling() {
+    // A level of rooms scattered around the camera, each holding NODES / ROOMS objects with
+    // bounds. The default camera looks down the negative z axis, so most rooms are off-screen.
+    std::mt19937                           rng{12345};
+    std::uniform_real_distribution<double> spread{-500, 500}, inRoom{-10, 10};
+    std::vector<Transform>                 nodes;
+    nodes.reserve(1 + ROOMS + NODES);
+    auto &root = nodes.emplace_back();
+    for (std::size_t r = 0; r < ROOMS; r++) {
+        auto &room = nodes.emplace_back(
+            Transform::Builder().withPosition({spread(rng), 0, spread(rng)}).withParent(root));
+        for (std::size_t i = 0; i < NODES / ROOMS; i++) {
+            auto &object = nodes.emplace_back(Transform::Builder()
+                                                  .withPosition({inRoom(rng), 0, inRoom(rng)})
+                                                  .withParent(room));
+            object.setLocalBounds(Transform::Sphere{{0, 0, 0}, 0.5});
+        }
+    }
+    Camera camera;
+    auto   frustum = camera.frustum();
+
+    // Test every object's own bounds, as a flat list of objects would.
+    std::vector<const Transform *> visible;
+    benchmark("Cull/Flat", 10, NODES, [&] {
+        visible.clear();
+        for (auto &node : nodes) {
+            if (auto bounds = node.localBounds()) {
+                auto center = glm::vec3(node.localToWorldMatrix() * glm::dvec4(bounds->center, 1));
+                if (frustum.intersectsSphere(center, static_cast<float>(bounds->radius))) {
+                    visible.push_back(&node);
+                }
+            }
+        }
+        keep(static_cast<double>(visible.size()));
+    });
+    benchmark("Cull/Hierarchy", 10, NODES, [&] {
+        root.cull(frustum, visible);
+        keep(static_cast<double>(visible.size()));
+    });
+    // Move one room per run, so that only its branch's bounds have to be refreshed.
+    double x = 0;
+    benchmark("Cull/Hierarchy/MovedRoom", 10, NODES, [&] {
+        nodes[1].setLocalPosition({x++, 0, -100});
+        root.cull(frustum, visible);
+        keep(static_cast<double>(visible.size()));
+    });
+    teardown(nodes);
+}
+
+static void
+benchmarkOcclusion() {
+    // A dungeon of parallel walls across the camera's view, one every 10 units, each with a
+    // doorway at a random point, and NODES objects scattered between them.
+    std::mt19937                          rng{12345};
+    std::uniform_real_distribution<float> across{-200, 200}, deep{-10.0f * WALLS, 0}, up{0, 2};
+    std::vector<glm::vec3>                vertices;
+    std::vector<std::uint32_t>            indices;
+    auto addQuad = [&](float left, float right, float z) {
+        auto first = static_cast<std::uint32_t>(vertices.size());
+        vertices.insert(
+            vertices.end(),
+            {glm::vec3{left, -1, z}, glm::vec3{right, -1, z}, glm::vec3{right, 3, z},
+             glm::vec3{left, 3, z}});
+        indices.insert(indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    };
+    for (std::size_t w = 1; w <= WALLS; w++) {
+        auto z    = -10.0f * static_cast<float>(w);
+        auto door = across(rng);
+        addQuad(-200, door - 2, z);
+        addQuad(door + 2, 200, z);
+    }
+    std::vector<float> x(NODES), y(NODES), z(NODES), extent(NODES, 0.5f);
+    for (std::size_t i = 0; i < NODES; i++) {
+        x[i] = across(rng);
+        y[i] = up(rng);
+        z[i] = deep(rng);
+    }
+    Frustum::Boxes boxes{x, y, z, extent, extent, extent};
+
+    Camera camera;
+    camera.transform.setPosition({0, 1, 0});
+    auto            viewProjection = camera.getMatrix(16.0f / 9.0f);
+    Frustum         frustum(viewProjection);
+    OcclusionBuffer occlusion(256, 144);
+    std::vector<std::uint32_t> visible(NODES);
+
+    auto frustumDraws   = frustum.cull(boxes, visible);
+    auto occlusionDraws = std::size_t{0};
+    benchmark("Occlusion/Rasterize", 10, indices.size() / 3, [&] {
+        occlusion.clear(viewProjection);
+        occlusion.rasterize(vertices, indices);
+        occlusion.buildHierarchy();
+    });
+    benchmark("Occlusion/Cull", 10, frustumDraws, [&] {
+        auto count     = frustum.cull(boxes, visible);
+        occlusionDraws = occlusion.cull(boxes, std::span(visible).first(count));
+    });
+    std::fprintf(
+        stderr,
+        "Draws of %zu objects: %zu after frustum culling, %zu after occlusion culling too\n",
+        NODES,
+        frustumDraws,
+        occlusionDraws);
+}
+
+// Benchmark names never contain characters that need escaping.
+static void
+writeJson(std::FILE *out) {
+    std::fprintf(out, "{\n  \"benchmarks\": [");
+    for (std::size_t i = 0; i < results.size(); i++) {
+        std::fprintf(
+            out,
+            "%s\n    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f}",
+            i ? "," : "",
+            results[i].name.c_str(),
+            results[i].nsPerOp,
+            results[i].allocsPerOp);
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+/***
+ * Usage: roguelike_transform_bench [output.json]
+ * A human-readable table is printed to stderr as each benchmark finishes. The results are written
+ * as JSON to the given file, or to stdout if none is given.
+ */
+int
+main(int argc, char *argv[]) {
+    // Also in 64-byte cache lines, which a walk over many Transforms pulls in per node.
+    std::fprintf(
+        stderr,
+        "sizeof(Transform) = %zu (%.2f lines), sizeof(TransformF) = %zu (%.2f lines)\n",
+        sizeof(Transform),
+        static_cast<double>(sizeof(Transform)) / 64,
+        sizeof(TransformF),
+        static_cast<double>(sizeof(TransformF)) / 64);
+    benchmarkConstruction();
+    benchmarkShapes();
+    benchmarkReparent();
+    benchmarkAccessors();
+    benchmarkBatches();
+    benchmarkCulling();
+    benchmarkOcclusion();
+
+    if (argc < 2) {
+        writeJson(stdout);
+        return 0;
+    }
+    auto *out = std::fopen(argv[1], "w");
+    if (!out) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    writeJson(out);
+    std::fclose(out);
+    return 0;
+}
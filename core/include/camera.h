@@ -24,13 +24,34 @@
 #    pragma GCC diagnostic pop
 #endif
 
+#include <cstdint>
+
+#include "frustum.h"
 #include "transform.h"
 
+/***
+ * A perspective camera placed by a Transform and aimed by a yaw and pitch. Its view and projection
+ * matrices, their product, and their inverses are cached. Each is rebuilt only when something it
+ * depends on changes: the rotation, field of view, clipping planes, aspect ratio, origin, or the
+ * world matrix of the transform, which is checked through Transform::worldGeneration().
+ */
 class Camera {
 public:
     Transform transform;
 
+    // The cached matrices. All of them are relative to the camera's origin.
+    struct Matrices {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 viewProjection;
+        glm::mat4 inverseView;
+        glm::mat4 inverseProjection;
+        glm::mat4 inverseViewProjection;
+    };
+
 public:
+    Camera();
+
     [[nodiscard]] std::pair<float, float>
     getSensitivity() const;
 
@@ -76,9 +97,56 @@ public:
     [[nodiscard]] glm::vec3
     up() const;
 
+    // Get the viewport's width divided by its height.
+    [[nodiscard]] float
+    getAspect() const;
+
+    // Set the viewport's width divided by its height. NaN, as from an empty viewport, counts as 1.
+    void
+    setAspect(float aspect);
+
+    // Get the world-space point that the cached matrices treat as (0, 0, 0).
+    [[nodiscard]] const glm::dvec3 &
+    getOrigin() const;
+
+    // Set the world-space point that the cached matrices treat as (0, 0, 0). See getMatrix().
+    void
+    setOrigin(const glm::dvec3 &origin);
+
+    /**
+     * Get the view and projection matrices and their inverses, bringing them up to date first.
+     * Only the view and the projection whose inputs have changed are rebuilt, and the products
+     * only if either was, so other systems may call this as often as they like.
+     * @return the matrices, which remain valid until the camera is next changed
+     */
+    [[nodiscard]] const Matrices &
+    matrices() const;
+
+    // Get the frustum of the view-projection matrix. Like the matrices, its planes are relative to
+    // the camera's origin.
+    [[nodiscard]] Frustum
+    frustum() const;
+
+    // Get the view-projection matrix at the given aspect ratio, relative to the world origin.
     [[nodiscard]] glm::mat4
     getMatrix(float aspect) const;
 
+    /**
+     * Get the view-projection matrix for a world that has been translated so that origin sits at
+     * (0, 0, 0), such as matrices exported relative to the same origin with
+     * Transform::exportWorldMatrices(). The camera's offset from origin is found in double
+     * precision, so passing the camera's own position keeps everything near the camera precise in
+     * single precision, however far it is from the world origin.
+     * Unlike setAspect() and setOrigin(), this leaves the cached matrices as they are, and only
+     * builds what differs from them, so a renderer that sets both once and reads matrices() each
+     * frame does less work.
+     * @param aspect the viewport's width divided by its height. NaN counts as 1.
+     * @param origin the world-space point that has been moved to (0, 0, 0)
+     * @return the view-projection matrix
+     */
+    [[nodiscard]] glm::mat4
+    getMatrix(float aspect, const glm::dvec3 &origin) const;
+
 private:
     std::pair<float, float> sens_{0.1f, 0.1f};
     float                   yaw_{glm::pi<float>()};
@@ -86,8 +154,20 @@ private:
     float                   fov_{glm::half_pi<float>()};
     float                   near_{0.01f};
     float                   far_{1000.0f};
+    float                   aspect_{1.0f};
+    glm::dvec3              origin_{0, 0, 0};
+    // The camera's axes, recomputed by updateAxes() whenever the yaw or pitch change.
+    glm::vec3 forward_{};
+    glm::vec3 right_{};
+    glm::vec3 up_{};
+
+    mutable Matrices matrices_{};
+    mutable bool     viewDirty_{true};
+    mutable bool     projectionDirty_{true};
+    // The transform's worldGeneration() when the view matrix was last built.
+    mutable std::uint64_t viewGeneration_{0};
 
 private:
-    [[nodiscard]] glm::mat4
-    viewMatrix() const;
+    void
+    updateAxes();
 };
@@ -0,0 +1,55 @@
+//
+// Created by taylor-santos on 10/17/2026 at 10:05.
+//
+
+#pragma once
+
+#include <cstdint>
+
+/***
+ * Schedules a simulation that runs in fixed-size steps, however fast frames are rendered. Each
+ * frame, advance() adds the real time that has passed to an accumulator and returns how many whole
+ * steps are now due. The time left over, as a fraction of a step, is alpha(), which the renderer
+ * uses to interpolate between the last two simulated states (see BasicTransformInterpolation).
+ * A simulation step that takes longer than the step itself would fall further behind every frame,
+ * so at most maxSteps are run per call, and any time beyond that is dropped.
+ */
+class FixedTimestep {
+public:
+    /**
+     * @param step the length of a simulation step, in seconds
+     * @param maxSteps the most steps advance() will ask for at once
+     * @throws std::invalid_argument if step is not positive or maxSteps is 0
+     */
+    explicit FixedTimestep(double step, std::uint32_t maxSteps = 8);
+
+    /**
+     * Account for elapsed real time.
+     * @param elapsed the seconds since the last call. Negative values are treated as 0.
+     * @return the number of steps to simulate now, at most maxSteps
+     */
+    [[nodiscard]] std::uint32_t
+    advance(double elapsed);
+
+    // Get the length of a simulation step, in seconds.
+    [[nodiscard]] double
+    step() const;
+
+    // Get how far real time is past the most recent step, as a fraction of a step in [0, 1].
+    [[nodiscard]] double
+    alpha() const;
+
+    // Get the simulated time, in seconds: the number of steps run so far times the step length.
+    [[nodiscard]] double
+    time() const;
+
+    // Get the number of steps run so far.
+    [[nodiscard]] std::uint64_t
+    steps() const;
+
+private:
+    double        step_;
+    std::uint32_t maxSteps_;
+    double        accumulator_{0};
+    std::uint64_t steps_{0};
+};
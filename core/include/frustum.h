@@ -0,0 +1,116 @@
+//
+// Created by taylor-santos on 10/17/2026 at 11:30.
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#if defined(__clang__)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wunknown-warning-option"
+#    pragma clang diagnostic ignored "-Wdeprecated-volatile"
+#elif defined(__GNUC__) || defined(__GNUG__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wpragmas"
+#    pragma GCC diagnostic ignored "-Wvolatile"
+#endif
+
+#define GLM_FORCE_SILENT_WARNINGS // Suppress 'nonstandard extension used: nameless struct/union'
+#include "glm/glm.hpp"
+
+#if defined(__clang__)
+#    pragma clang diagnostic pop
+#elif defined(__GNUC__) || defined(__GNUG__)
+#    pragma GCC diagnostic pop
+#endif
+
+/***
+ * The six planes bounding the volume that a view-projection matrix maps onto the screen, used to
+ * skip drawing anything that lies entirely outside it. The planes are in whatever space the matrix
+ * maps from, so a Frustum built from a camera-relative matrix (see Camera::matrices()) must be
+ * tested against bounds relative to the same origin.
+ * The tests are conservative: anything that intersects the frustum is visible, and a few bounds
+ * just outside a corner of the frustum may be reported as visible too.
+ * The batch tests take bounds as structures of arrays and test as many bounds per step as fit in
+ * the widest available SIMD registers (see simd.h), writing out the indices of the visible ones.
+ */
+class Frustum {
+public:
+    enum class Side { LEFT, RIGHT, BOTTOM, TOP, NEAR_CLIP, FAR_CLIP };
+
+    // Spheres, one per index, as a structure of arrays. Every span must be the same size.
+    struct Spheres {
+        std::span<const float> x;
+        std::span<const float> y;
+        std::span<const float> z;
+        std::span<const float> radius;
+    };
+
+    // Axis-aligned boxes, one per index, given by their centers and half-extents along each axis,
+    // as a structure of arrays. Every span must be the same size.
+    struct Boxes {
+        std::span<const float> x;
+        std::span<const float> y;
+        std::span<const float> z;
+        std::span<const float> extentX;
+        std::span<const float> extentY;
+        std::span<const float> extentZ;
+    };
+
+    /**
+     * Extract the planes of a view-projection matrix's frustum.
+     * @param viewProjection an OpenGL-style projection matrix, whose clip space depth runs from -1
+     *        to 1, times the view matrix
+     */
+    explicit Frustum(const glm::mat4 &viewProjection);
+
+    /**
+     * Get one of the frustum's planes.
+     * @param side which plane to get
+     * @return the plane as (normal, distance), where the normal has unit length and points into the
+     *         frustum, so that dot(normal, p) + distance is a point p's distance inside the plane
+     */
+    [[nodiscard]] const glm::vec4 &
+    plane(Side side) const;
+
+    // Returns true if a sphere intersects the frustum.
+    [[nodiscard]] bool
+    intersectsSphere(const glm::vec3 &center, float radius) const;
+
+    // Returns true if a sphere lies entirely inside the frustum, so that anything it encloses is
+    // visible without further tests.
+    [[nodiscard]] bool
+    containsSphere(const glm::vec3 &center, float radius) const;
+
+    // Returns true if an axis-aligned box, given by its center and half-extents, intersects the
+    // frustum.
+    [[nodiscard]] bool
+    intersectsBox(const glm::vec3 &center, const glm::vec3 &extent) const;
+
+    /**
+     * Find every sphere that intersects the frustum.
+     * @param spheres the spheres to test
+     * @param visible receives the indices of the visible spheres, in increasing order
+     * @return the number of visible spheres, which have been written to the front of visible
+     * @throws std::invalid_argument if the spans in spheres differ in size, or visible is smaller
+     */
+    std::size_t
+    cull(const Spheres &spheres, std::span<std::uint32_t> visible) const;
+
+    /**
+     * Find every axis-aligned box that intersects the frustum.
+     * @param boxes the boxes to test
+     * @param visible receives the indices of the visible boxes, in increasing order
+     * @return the number of visible boxes, which have been written to the front of visible
+     * @throws std::invalid_argument if the spans in boxes differ in size, or visible is smaller
+     */
+    std::size_t
+    cull(const Boxes &boxes, std::span<std::uint32_t> visible) const;
+
+private:
+    std::array<glm::vec4, 6> planes_;
+};
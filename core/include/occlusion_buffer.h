@@ -0,0 +1,150 @@
+//
+// Created by taylor-santos on 10/17/2026 at 14:10.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if defined(__clang__)
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wunknown-warning-option"
+#    pragma clang diagnostic ignored "-Wdeprecated-volatile"
+#elif defined(__GNUC__) || defined(__GNUG__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wpragmas"
+#    pragma GCC diagnostic ignored "-Wvolatile"
+#endif
+
+#define GLM_FORCE_SILENT_WARNINGS // Suppress 'nonstandard extension used: nameless struct/union'
+#include "glm/glm.hpp"
+
+#if defined(__clang__)
+#    pragma clang diagnostic pop
+#elif defined(__GNUC__) || defined(__GNUG__)
+#    pragma GCC diagnostic pop
+#endif
+
+#include "frustum.h"
+
+/***
+ * A low-resolution depth buffer, rendered on the CPU from a few large occluders such as walls,
+ * used to skip drawing anything hidden entirely behind them. Each frame, clear() the buffer with
+ * the camera's view-projection matrix, rasterize() every occluder, then buildHierarchy() before
+ * testing bounds. Triangles are filled as many pixels per step as fit in the widest available SIMD
+ * registers (see simd.h), and bounds are tested against a hierarchy of coarser copies of the
+ * buffer, each holding the farthest depth of four texels of the one before, so that a test reads
+ * at most a few texels however much of the screen the bounds cover.
+ * Like the Frustum, everything is in whatever space the matrix maps from, so bounds must be
+ * relative to the same origin as the matrix (see Camera::getMatrix()).
+ * Occluders are sampled at pixel centers, so an object seen only through a gap narrower than one
+ * of the buffer's pixels may be reported as occluded. Everything else errs towards visible.
+ */
+class OcclusionBuffer {
+public:
+    /**
+     * Allocate a buffer. It must be cleared before use.
+     * @param width the width in pixels, typically a fraction of the screen's
+     * @param height the height in pixels
+     * @throws std::invalid_argument if either dimension is zero
+     */
+    OcclusionBuffer(std::uint32_t width, std::uint32_t height);
+
+    [[nodiscard]] std::uint32_t
+    width() const;
+
+    [[nodiscard]] std::uint32_t
+    height() const;
+
+    /**
+     * Reset every pixel to the far plane, and set the matrix that occluders and bounds are
+     * projected with.
+     * @param viewProjection an OpenGL-style projection matrix, whose clip space depth runs from -1
+     *        to 1, times the view matrix, e.g. Camera::getMatrix()
+     */
+    void
+    clear(const glm::mat4 &viewProjection);
+
+    /**
+     * Render an occluder's triangles into the buffer. Both sides of each triangle occlude, and
+     * triangles that cross the near plane are clipped against it.
+     * @param vertices the occluder's vertices
+     * @param indices three vertex indices per triangle
+     * @param model the matrix placing the vertices in the space that the view-projection matrix
+     *        maps from
+     * @throws std::invalid_argument if the number of indices isn't a multiple of three, or an index
+     *         is out of range
+     */
+    void
+    rasterize(
+        std::span<const glm::vec3>     vertices,
+        std::span<const std::uint32_t> indices,
+        const glm::mat4               &model = glm::mat4(1));
+
+    // Rebuild the hierarchy from the buffer. Must be called after the last occluder is rasterized
+    // and before any bounds are tested.
+    void
+    buildHierarchy();
+
+    /**
+     * Check whether an axis-aligned box is hidden behind the occluders. Boxes that reach in front
+     * of the near plane, or lie entirely off-screen or beyond the far plane, are never reported as
+     * occluded, since the Frustum is left to cull them.
+     * @param center the box's center
+     * @param extent the box's half-extents along each axis
+     * @return true if every pixel the box could cover is nearer to an occluder than the box
+     * @throws std::logic_error if the hierarchy is out of date with the buffer
+     */
+    [[nodiscard]] bool
+    occludesBox(const glm::vec3 &center, const glm::vec3 &extent) const;
+
+    // Same as occludesBox(), for the box enclosing a sphere.
+    [[nodiscard]] bool
+    occludesSphere(const glm::vec3 &center, float radius) const;
+
+    /**
+     * Remove every occluded box from a list of candidates, such as the output of
+     * Frustum::cull(), keeping the rest in order.
+     * @param boxes the boxes the candidates index into
+     * @param visible the indices of the candidate boxes, of which the unoccluded ones are moved to
+     *        the front
+     * @return the number of unoccluded boxes
+     * @throws std::invalid_argument if the spans in boxes differ in size, or an index is out of
+     *         range
+     * @throws std::logic_error if the hierarchy is out of date with the buffer
+     */
+    std::size_t
+    cull(const Frustum::Boxes &boxes, std::span<std::uint32_t> visible) const;
+
+    /**
+     * Get the depth of one of the buffer's pixels.
+     * @param x the pixel's column
+     * @param y the pixel's row, where row 0 is the bottom of the screen
+     * @return the depth, from 0 at the near plane to 1 at the far plane
+     * @throws std::out_of_range if the pixel is outside the buffer
+     */
+    [[nodiscard]] float
+    depth(std::uint32_t x, std::uint32_t y) const;
+
+private:
+    // One level of the hierarchy. Level 0 is the buffer itself, whose rows are padded to a whole
+    // number of SIMD packs so that the rasterizer never needs a partial load or store.
+    struct Level {
+        std::uint32_t      width;
+        std::uint32_t      height;
+        std::uint32_t      stride;
+        std::vector<float> depth;
+    };
+
+    std::vector<Level> levels_;
+    glm::mat4          viewProjection_{1};
+    // Cleared by clear() and rasterize(), and set by buildHierarchy().
+    bool hierarchyBuilt_{false};
+
+    // Fill one triangle, whose vertices are in clip space and in front of the near plane.
+    void
+    fillTriangle(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c);
+};
@@ -0,0 +1,556 @@
+//
+// Created by taylor-santos on 10/16/2026 at 21:07.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+// Pick the widest instruction set the compiler has been told it may use. AVX2 builds (see the
+// ENABLE_AVX2 CMake option) also define __AVX__. x86-64 always has SSE2, but MSVC doesn't advertise
+// it with __SSE2__.
+#if defined(__AVX__)
+#    include <immintrin.h>
+#    define SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define SIMD_SSE2
+#endif
+
+namespace Simd {
+
+/***
+ * A fixed-width group of lanes of type T that are all operated on at once. Kernels written against
+ * Pack process Pack<T>::width independent inputs per iteration, one per lane. Pack<float> and
+ * Pack<double> map onto AVX or SSE2 registers when available. The primary template is a
+ * single-lane scalar fallback, used for any other T or when neither instruction set is enabled.
+ * Comparisons return a Mask, which can only be combined with & and consumed by select() or
+ * Pack::bits().
+ */
+template<typename T>
+class Pack {
+public:
+    using Mask = bool;
+
+    static constexpr std::size_t width = 1;
+
+    Pack() = default;
+
+    // Broadcast a single value to every lane.
+    Pack(T value)
+        : v_{value} {}
+
+    // Load width consecutive values.
+    static Pack
+    load(const T *src) {
+        return *src;
+    }
+
+    // Store each lane into width consecutive values.
+    void
+    store(T *dst) const {
+        *dst = v_;
+    }
+
+    // Load lane i from src[i * stride].
+    static Pack
+    gather(const T *src, std::size_t) {
+        return *src;
+    }
+
+    // Store lane i into dst[i * stride].
+    void
+    scatter(T *dst, std::size_t) const {
+        *dst = v_;
+    }
+
+    friend Pack
+    operator+(Pack a, Pack b) {
+        return a.v_ + b.v_;
+    }
+
+    friend Pack
+    operator-(Pack a, Pack b) {
+        return a.v_ - b.v_;
+    }
+
+    friend Pack
+    operator-(Pack a) {
+        return -a.v_;
+    }
+
+    friend Pack
+    operator*(Pack a, Pack b) {
+        return a.v_ * b.v_;
+    }
+
+    friend Pack
+    operator/(Pack a, Pack b) {
+        return a.v_ / b.v_;
+    }
+
+    friend Mask
+    operator<(Pack a, Pack b) {
+        return a.v_ < b.v_;
+    }
+
+    friend Mask
+    operator>(Pack a, Pack b) {
+        return a.v_ > b.v_;
+    }
+
+    friend Pack
+    sqrt(Pack a) {
+        return std::sqrt(a.v_);
+    }
+
+    // Take each lane from a where mask is set, and from b where it is not.
+    friend Pack
+    select(Mask mask, Pack a, Pack b) {
+        return mask ? a : b;
+    }
+
+    // Get a bitmask with bit i set if lane i of mask is set.
+    static unsigned
+    bits(Mask mask) {
+        return mask ? 1 : 0;
+    }
+
+private:
+    T v_{};
+};
+
+#if defined(SIMD_AVX)
+
+template<>
+class Pack<double> {
+public:
+    using Mask = Pack;
+
+    static constexpr std::size_t width = 4;
+
+    Pack() = default;
+
+    Pack(double value)
+        : v_{_mm256_set1_pd(value)} {}
+
+    Pack(__m256d v)
+        : v_{v} {}
+
+    static Pack
+    load(const double *src) {
+        return _mm256_loadu_pd(src);
+    }
+
+    void
+    store(double *dst) const {
+        _mm256_storeu_pd(dst, v_);
+    }
+
+    static Pack
+    gather(const double *src, std::size_t stride) {
+        return _mm256_set_pd(src[3 * stride], src[2 * stride], src[stride], src[0]);
+    }
+
+    void
+    scatter(double *dst, std::size_t stride) const {
+        alignas(32) double lanes[width];
+        _mm256_store_pd(lanes, v_);
+        for (std::size_t i = 0; i < width; i++) dst[i * stride] = lanes[i];
+    }
+
+    friend Pack
+    operator+(Pack a, Pack b) {
+        return _mm256_add_pd(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator-(Pack a, Pack b) {
+        return _mm256_sub_pd(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator-(Pack a) {
+        return _mm256_xor_pd(a.v_, _mm256_set1_pd(-0.0));
+    }
+
+    friend Pack
+    operator*(Pack a, Pack b) {
+        return _mm256_mul_pd(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator/(Pack a, Pack b) {
+        return _mm256_div_pd(a.v_, b.v_);
+    }
+
+    friend Mask
+    operator<(Pack a, Pack b) {
+        return _mm256_cmp_pd(a.v_, b.v_, _CMP_LT_OQ);
+    }
+
+    friend Mask
+    operator>(Pack a, Pack b) {
+        return _mm256_cmp_pd(a.v_, b.v_, _CMP_GT_OQ);
+    }
+
+    friend Mask
+    operator&(Mask a, Mask b) {
+        return _mm256_and_pd(a.v_, b.v_);
+    }
+
+    friend Pack
+    sqrt(Pack a) {
+        return _mm256_sqrt_pd(a.v_);
+    }
+
+    friend Pack
+    select(Mask mask, Pack a, Pack b) {
+        return _mm256_blendv_pd(b.v_, a.v_, mask.v_);
+    }
+
+    static unsigned
+    bits(Mask mask) {
+        return static_cast<unsigned>(_mm256_movemask_pd(mask.v_));
+    }
+
+private:
+    __m256d v_;
+};
+
+template<>
+class Pack<float> {
+public:
+    using Mask = Pack;
+
+    static constexpr std::size_t width = 8;
+
+    Pack() = default;
+
+    Pack(float value)
+        : v_{_mm256_set1_ps(value)} {}
+
+    Pack(__m256 v)
+        : v_{v} {}
+
+    static Pack
+    load(const float *src) {
+        return _mm256_loadu_ps(src);
+    }
+
+    void
+    store(float *dst) const {
+        _mm256_storeu_ps(dst, v_);
+    }
+
+    static Pack
+    gather(const float *src, std::size_t stride) {
+        return _mm256_set_ps(
+            src[7 * stride],
+            src[6 * stride],
+            src[5 * stride],
+            src[4 * stride],
+            src[3 * stride],
+            src[2 * stride],
+            src[stride],
+            src[0]);
+    }
+
+    void
+    scatter(float *dst, std::size_t stride) const {
+        alignas(32) float lanes[width];
+        _mm256_store_ps(lanes, v_);
+        for (std::size_t i = 0; i < width; i++) dst[i * stride] = lanes[i];
+    }
+
+    friend Pack
+    operator+(Pack a, Pack b) {
+        return _mm256_add_ps(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator-(Pack a, Pack b) {
+        return _mm256_sub_ps(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator-(Pack a) {
+        return _mm256_xor_ps(a.v_, _mm256_set1_ps(-0.0f));
+    }
+
+    friend Pack
+    operator*(Pack a, Pack b) {
+        return _mm256_mul_ps(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator/(Pack a, Pack b) {
+        return _mm256_div_ps(a.v_, b.v_);
+    }
+
+    friend Mask
+    operator<(Pack a, Pack b) {
+        return _mm256_cmp_ps(a.v_, b.v_, _CMP_LT_OQ);
+    }
+
+    friend Mask
+    operator>(Pack a, Pack b) {
+        return _mm256_cmp_ps(a.v_, b.v_, _CMP_GT_OQ);
+    }
+
+    friend Mask
+    operator&(Mask a, Mask b) {
+        return _mm256_and_ps(a.v_, b.v_);
+    }
+
+    friend Pack
+    sqrt(Pack a) {
+        return _mm256_sqrt_ps(a.v_);
+    }
+
+    friend Pack
+    select(Mask mask, Pack a, Pack b) {
+        return _mm256_blendv_ps(b.v_, a.v_, mask.v_);
+    }
+
+    static unsigned
+    bits(Mask mask) {
+        return static_cast<unsigned>(_mm256_movemask_ps(mask.v_));
+    }
+
+private:
+    __m256 v_;
+};
+
+#elif defined(SIMD_SSE2)
+
+template<>
+class Pack<double> {
+public:
+    using Mask = Pack;
+
+    static constexpr std::size_t width = 2;
+
+    Pack() = default;
+
+    Pack(double value)
+        : v_{_mm_set1_pd(value)} {}
+
+    Pack(__m128d v)
+        : v_{v} {}
+
+    static Pack
+    load(const double *src) {
+        return _mm_loadu_pd(src);
+    }
+
+    void
+    store(double *dst) const {
+        _mm_storeu_pd(dst, v_);
+    }
+
+    static Pack
+    gather(const double *src, std::size_t stride) {
+        return _mm_set_pd(src[stride], src[0]);
+    }
+
+    void
+    scatter(double *dst, std::size_t stride) const {
+        _mm_storel_pd(dst, v_);
+        _mm_storeh_pd(dst + stride, v_);
+    }
+
+    friend Pack
+    operator+(Pack a, Pack b) {
+        return _mm_add_pd(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator-(Pack a, Pack b) {
+        return _mm_sub_pd(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator-(Pack a) {
+        return _mm_xor_pd(a.v_, _mm_set1_pd(-0.0));
+    }
+
+    friend Pack
+    operator*(Pack a, Pack b) {
+        return _mm_mul_pd(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator/(Pack a, Pack b) {
+        return _mm_div_pd(a.v_, b.v_);
+    }
+
+    friend Mask
+    operator<(Pack a, Pack b) {
+        return _mm_cmplt_pd(a.v_, b.v_);
+    }
+
+    friend Mask
+    operator>(Pack a, Pack b) {
+        return _mm_cmpgt_pd(a.v_, b.v_);
+    }
+
+    friend Mask
+    operator&(Mask a, Mask b) {
+        return _mm_and_pd(a.v_, b.v_);
+    }
+
+    friend Pack
+    sqrt(Pack a) {
+        return _mm_sqrt_pd(a.v_);
+    }
+
+    friend Pack
+    select(Mask mask, Pack a, Pack b) {
+        // SSE2 has no blend instruction, so combine the two halves by hand.
+        return _mm_or_pd(_mm_and_pd(mask.v_, a.v_), _mm_andnot_pd(mask.v_, b.v_));
+    }
+
+    static unsigned
+    bits(Mask mask) {
+        return static_cast<unsigned>(_mm_movemask_pd(mask.v_));
+    }
+
+private:
+    __m128d v_;
+};
+
+template<>
+class Pack<float> {
+public:
+    using Mask = Pack;
+
+    static constexpr std::size_t width = 4;
+
+    Pack() = default;
+
+    Pack(float value)
+        : v_{_mm_set1_ps(value)} {}
+
+    Pack(__m128 v)
+        : v_{v} {}
+
+    static Pack
+    load(const float *src) {
+        return _mm_loadu_ps(src);
+    }
+
+    void
+    store(float *dst) const {
+        _mm_storeu_ps(dst, v_);
+    }
+
+    static Pack
+    gather(const float *src, std::size_t stride) {
+        return _mm_set_ps(src[3 * stride], src[2 * stride], src[stride], src[0]);
+    }
+
+    void
+    scatter(float *dst, std::size_t stride) const {
+        alignas(16) float lanes[width];
+        _mm_store_ps(lanes, v_);
+        for (std::size_t i = 0; i < width; i++) dst[i * stride] = lanes[i];
+    }
+
+    friend Pack
+    operator+(Pack a, Pack b) {
+        return _mm_add_ps(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator-(Pack a, Pack b) {
+        return _mm_sub_ps(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator-(Pack a) {
+        return _mm_xor_ps(a.v_, _mm_set1_ps(-0.0f));
+    }
+
+    friend Pack
+    operator*(Pack a, Pack b) {
+        return _mm_mul_ps(a.v_, b.v_);
+    }
+
+    friend Pack
+    operator/(Pack a, Pack b) {
+        return _mm_div_ps(a.v_, b.v_);
+    }
+
+    friend Mask
+    operator<(Pack a, Pack b) {
+        return _mm_cmplt_ps(a.v_, b.v_);
+    }
+
+    friend Mask
+    operator>(Pack a, Pack b) {
+        return _mm_cmpgt_ps(a.v_, b.v_);
+    }
+
+    friend Mask
+    operator&(Mask a, Mask b) {
+        return _mm_and_ps(a.v_, b.v_);
+    }
+
+    friend Pack
+    sqrt(Pack a) {
+        return _mm_sqrt_ps(a.v_);
+    }
+
+    friend Pack
+    select(Mask mask, Pack a, Pack b) {
+        // SSE2 has no blend instruction, so combine the two halves by hand.
+        return _mm_or_ps(_mm_and_ps(mask.v_, a.v_), _mm_andnot_ps(mask.v_, b.v_));
+    }
+
+    static unsigned
+    bits(Mask mask) {
+        return static_cast<unsigned>(_mm_movemask_ps(mask.v_));
+    }
+
+private:
+    __m128 v_;
+};
+
+#endif
+
+/**
+ * Narrow count doubles to floats, four at a time when AVX or SSE2 is available.
+ * @param src the doubles to convert, with no alignment requirement
+ * @param dst receives the floats, and must be 16-byte aligned
+ * @param count the number of values to convert
+ */
+inline void
+narrow(const double *src, float *dst, std::size_t count) {
+    std::size_t i = 0;
+#if defined(SIMD_AVX) || defined(SIMD_SSE2)
+    for (std::size_t end = count - count % 4; i < end; i += 4) {
+#    if defined(SIMD_AVX)
+        _mm_store_ps(dst + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+#    else
+        // Each conversion fills the low half of a register, so pack two of them together.
+        auto lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+        auto hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+        _mm_store_ps(dst + i, _mm_movelh_ps(lo, hi));
+#    endif
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+}
+
+// Copy count floats, so that generic code can narrow from either precision.
+inline void
+narrow(const float *src, float *dst, std::size_t count) {
+    std::copy_n(src, count, dst);
+}
+
+} // namespace Simd
@@ -0,0 +1,114 @@
+//
+// Created by taylor-santos on 10/16/2026 at 22:14.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***
+ * A fixed-size pool of worker threads that share work by stealing. Each worker owns a deque of
+ * tasks: tasks submitted from a worker are pushed onto its own deque and popped back off in LIFO
+ * order, which keeps a subtree's work on the thread whose cache already holds its parent. An idle
+ * worker steals from the opposite end of another worker's deque. Tasks submitted from outside the
+ * pool are distributed round-robin.
+ * Use a TaskGroup to wait for a batch of tasks to finish.
+ */
+class ThreadPool {
+public:
+    /***
+     * A set of tasks that can be waited on together. Tasks may add further tasks to the same group
+     * while it is running. Waiting on a group runs pending tasks on the waiting thread instead of
+     * blocking, so a group can be waited on from inside another task, or with a pool that has no
+     * workers at all.
+     */
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool &pool);
+
+        // Waits for any tasks that are still pending, discarding their exceptions.
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &
+        operator=(const TaskGroup &) = delete;
+
+        // Submit a task to the pool as part of this group.
+        void
+        run(std::function<void()> task);
+
+        /**
+         * Run or wait for every task in this group, including tasks that those tasks add.
+         * @throws the first exception thrown by any of the group's tasks, after all have finished
+         */
+        void
+        wait();
+
+    private:
+        ThreadPool              &pool_;
+        std::atomic<std::size_t> pending_{0};
+        std::mutex               errorMutex_;
+        std::exception_ptr       error_;
+    };
+
+    /**
+     * Start a pool with the given number of worker threads.
+     * @param threadCount the number of workers. With zero workers, tasks only run when a TaskGroup
+     *        is waited on.
+     */
+    explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+
+    // Finish every task that has been submitted, then join the workers.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &
+    operator=(const ThreadPool &) = delete;
+
+    // Get the number of worker threads.
+    [[nodiscard]] std::size_t
+    size() const;
+
+    // Submit a task to be run by one of the workers.
+    void
+    submit(std::function<void()> task);
+
+    // Run a single pending task on the calling thread, if there is one. Returns true if a task was
+    // run.
+    bool
+    runPendingTask();
+
+private:
+    struct Queue {
+        std::mutex                        mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread>            workers_;
+    std::atomic<std::size_t>            nextQueue_{0};
+    // The total number of tasks across all queues.
+    std::atomic<std::size_t> queued_{0};
+    std::mutex               sleepMutex_;
+    std::condition_variable  sleepCondition_;
+    bool                     stopping_{false};
+
+private:
+    // Take a task, preferring the back of the given queue, then stealing from the front of the
+    // others. Returns an empty function if every queue is empty.
+    std::function<void()>
+    take(std::size_t queueIndex);
+
+    // The main loop of the worker that owns the given queue.
+    void
+    work(std::size_t queueIndex);
+};
@@ -4,9 +4,12 @@
 
 #pragma once
 
-#include <list>
+#include <cstdint>
+#include <memory>
 #include <ostream>
 #include <optional>
+#include <span>
+#include <vector>
 
 #if defined(__clang__)
 #    pragma clang diagnostic push
@@ -29,53 +32,124 @@
 #    pragma GCC diagnostic pop
 #endif
 
-class Transform {
+class Frustum;
+class ThreadPool;
+
+template<typename T>
+class BasicTransformJournal;
+
+template<typename T>
+class BasicTransformBake;
+
+/***
+ * A node in a hierarchy of affine transformations, templated on its scalar type. Every
+ * vector, quaternion, and matrix the class stores or returns uses T, so a single-precision
+ * Transform is half the size of a double-precision one and its matrices can be handed to OpenGL
+ * without conversion. Only the float and double instantiations are provided, through the Transform
+ * and TransformF aliases below.
+ * Rigid hierarchies, where every ancestor has uniform positive scale and no skew, take a fast path:
+ * world-space properties are composed from the parent's with quaternion math, and world-preserving
+ * reparents are solved the same way, so no matrix is ever decomposed. As soon as skew or
+ * non-uniform scale appears above a Transform, it falls back to decomposing its world matrix.
+ */
+template<typename T>
+class BasicTransform {
 public:
+    using Vec3 = glm::vec<3, T, glm::defaultp>;
+    using Vec4 = glm::vec<4, T, glm::defaultp>;
+    using Quat = glm::qua<T, glm::defaultp>;
+    using Mat3 = glm::mat<3, 3, T, glm::defaultp>;
+    using Mat4 = glm::mat<4, 4, T, glm::defaultp>;
+
     class Builder {
     public:
         Builder() = default;
 
         // Set the Transform's parent
         Builder &
-        withParent(Transform &parent);
+        withParent(BasicTransform &parent);
 
         // Set the Transform's position
         Builder &
-        withPosition(glm::dvec3 position);
+        withPosition(Vec3 position);
 
         // Set the Transform's rotation
         Builder &
-        withRotation(glm::dquat rotation);
+        withRotation(Quat rotation);
 
         // Set the Transform's scale
         Builder &
-        withScale(glm::dvec3 scale);
+        withScale(Vec3 scale);
 
         // Set the Transform's skew
         Builder &
-        withSkew(glm::dvec3 skew);
+        withSkew(Vec3 skew);
 
         // Build the Transform with the requested properties
-        [[nodiscard]] Transform
+        [[nodiscard]] BasicTransform
         build() const;
 
         // Implicit conversion operator - Use a Builder in a context where a Transform is expected,
         // and it will invoke build() automatically.
-        operator Transform() const;
+        operator BasicTransform() const;
+
+    private:
+        BasicTransform *parent_{nullptr};
+        Vec3            position_{0, 0, 0};
+        Quat            rotation_{glm::quat_identity<T, glm::defaultp>()};
+        Vec3            scale_{1, 1, 1};
+        Vec3            skew_{0, 0, 0};
+    };
+
+    /***
+     * A batch of reparenting operations that are validated and applied together by commit().
+     * Calling setParent() on many Transforms in turn walks every new parent's ancestors to check
+     * for cycles and decomposes a world matrix on every call, which becomes quadratic when
+     * restructuring a large hierarchy. An Edit records its operations without touching the
+     * hierarchy. commit() then checks the final hierarchy for cycles in a single pass, and
+     * decomposes each world-preserving Transform's matrix exactly once.
+     * Every Transform given to an Edit must outlive its commit(). An Edit that is destroyed
+     * without being committed has no effect.
+     */
+    class Edit {
+    public:
+        Edit() = default;
+
+        /**
+         * Record a change of parent, to be applied by commit(). If the same child is given more
+         * than once, only the last change is applied.
+         * @param child the Transform to be reparented
+         * @param parent the new parent, or nullptr to remove the child's parent
+         * @param preserveLocalSpace whether to keep the child's local (true) or world (false)
+         *        characteristics fixed. World characteristics are those from before commit().
+         * @return a reference to this Edit, so calls may be chained
+         */
+        Edit &
+        setParent(BasicTransform &child, BasicTransform *parent, bool preserveLocalSpace = false);
+
+        /**
+         * Apply every recorded change, then clear them so that the Edit may be reused.
+         * @throws std::invalid_argument if the changes would create a cycle in the hierarchy, in
+         *         which case no Transform is modified and the changes are discarded
+         */
+        void
+        commit();
 
     private:
-        Transform *parent_{nullptr};
-        glm::dvec3 position_{0, 0, 0};
-        glm::dquat rotation_{glm::quat_identity<double, glm::defaultp>()};
-        glm::dvec3 scale_{1, 1, 1};
-        glm::dvec3 skew_{0, 0, 0};
+        struct Reparent {
+            BasicTransform *child;
+            BasicTransform *parent;
+            bool            preserveLocalSpace;
+        };
+
+        std::vector<Reparent> reparents_;
     };
 
     struct Properties {
-        glm::dvec3 translation{0, 0, 0};
-        glm::dquat rotation{glm::quat_identity<double, glm::defaultp>()};
-        glm::dvec3 scale{1, 1, 1};
-        glm::dvec3 skew{0, 0, 0};
+        Vec3 translation{0, 0, 0};
+        Quat rotation{glm::quat_identity<T, glm::defaultp>()};
+        Vec3 scale{1, 1, 1};
+        Vec3 skew{0, 0, 0};
     };
 
     /***
@@ -86,7 +160,7 @@ public:
      * matrix
      */
     static Properties
-    decompose(glm::dmat4 mat);
+    decompose(Mat4 mat);
 
     /***
      * Reconstruct an affine matrix from its translation, rotation, scale, and skew.
@@ -94,8 +168,8 @@ public:
      * matrix
      * @return a 4x4 affine matrix representing the same transformation as the input parameters
      */
-    static glm::dmat4
-    recompose(const Transform::Properties &mat);
+    static Mat4
+    recompose(const Properties &mat);
 
     /***
      * Reconstruct an affine matrix from the inverse of its translation, rotation, scale, and skew.
@@ -103,30 +177,96 @@ public:
      * joined into a matrix
      * @return a 4x4 affine matrix representing the inverted transformation of the input parameters
      */
-    static glm::dmat4
-    recomposeInverse(const Transform::Properties &mat);
+    static Mat4
+    recomposeInverse(const Properties &mat);
+
+    /***
+     * Invert an affine matrix. Only the upper 3x3 block needs a general inverse, which is computed
+     * in closed form from the cross products of its columns; the translation is then carried
+     * through it. Much cheaper than glm::inverse(), which must handle arbitrary 4x4 matrices.
+     * @param mat a 4x4 affine matrix, whose bottom row is (0, 0, 0, 1)
+     * @return the inverse of mat
+     */
+    static Mat4
+    affineInverse(const Mat4 &mat);
+
+    /***
+     * Decompose many affine matrices at once. Equivalent to calling decompose() on each matrix,
+     * but processes as many matrices per step as fit in the widest available SIMD registers (see
+     * simd.h), falling back to one at a time if none are available.
+     * @param mats the 4x4 affine matrices to be decomposed
+     * @param out receives the translation, rotation, scale, and skew of each matrix
+     * @throws std::invalid_argument if mats and out are different sizes
+     */
+    static void
+    decompose(std::span<const Mat4> mats, std::span<Properties> out);
+
+    /***
+     * Reconstruct many affine matrices at once. Equivalent to calling recompose() on each element
+     * of props, but vectorized in the same way as the batch decompose().
+     * @param props the translation, rotation, scale, and skew of each matrix
+     * @param out receives the 4x4 affine matrices
+     * @throws std::invalid_argument if props and out are different sizes
+     */
+    static void
+    recompose(std::span<const Properties> props, std::span<Mat4> out);
+
+    /**
+     * Pack matrices into a buffer of single-precision floats, 16 per matrix in column-major order,
+     * so that the buffer can be copied straight into an instance or uniform buffer on the GPU.
+     * Double-precision matrices are narrowed with SIMD conversions.
+     * Far from the world origin, single-precision translations lose too much precision to render
+     * without jitter. Passing the camera's position as origin exports every matrix relative to
+     * the camera instead, subtracting it at full precision before narrowing, to be rendered with
+     * a view matrix relative to the same origin.
+     * @param mats the matrices to export
+     * @param out receives 16 floats per matrix, and must be 16-byte aligned
+     * @param origin the point to subtract from every matrix's translation
+     * @throws std::invalid_argument if out is not 16-byte aligned or does not hold exactly 16
+     *         floats per matrix
+     */
+    static void
+    exportMatrices(std::span<const Mat4> mats, std::span<float> out, Vec3 origin = Vec3(0));
+
+    /**
+     * Pack the world matrices of many Transforms into a buffer of single-precision floats, in the
+     * same layout and relative to the same kind of origin as exportMatrices(), without copying
+     * each matrix out of its cache first.
+     * @param transforms the Transforms whose local-to-world matrices to export
+     * @param out receives 16 floats per Transform, and must be 16-byte aligned
+     * @param origin the point to subtract from every world matrix's translation
+     * @throws std::invalid_argument if out is not 16-byte aligned or does not hold exactly 16
+     *         floats per Transform
+     */
+    static void
+    exportWorldMatrices(
+        std::span<const BasicTransform *const> transforms,
+        std::span<float>                       out,
+        Vec3                                   origin = Vec3(0));
 
-    Transform();
+    BasicTransform();
 
-    ~Transform();
+    // Children are detached, keeping them fixed in world space. A frozen Transform is removed from
+    // its BasicTransformBake, whose other matrices stay valid.
+    ~BasicTransform();
 
     /**
      * Copy a Transform's physical characteristics and make the copy share the same parent. Does not
-     * copy the original's children, if it has any.
+     * copy the original's children, if it has any, or its BasicTransformJournal tracking.
      * @param other the Transform to be copied
      */
-    Transform(const Transform &other);
+    BasicTransform(const BasicTransform &other);
 
     // Move constructor
-    Transform(Transform &&other) noexcept;
+    BasicTransform(BasicTransform &&other) noexcept;
 
     // Copy-assignment operator
-    Transform &
-    operator=(const Transform &other);
+    BasicTransform &
+    operator=(const BasicTransform &other);
 
     // Move-assignment operator
-    Transform &
-    operator=(Transform &&other) noexcept;
+    BasicTransform &
+    operator=(BasicTransform &&other) noexcept;
 
     /**
      * Compare the physical characteristics of two Transforms. If either has a parent, they must
@@ -135,11 +275,19 @@ public:
      * @return true if both Transforms have the same parent and characteristics, false otherwise
      */
     bool
-    operator==(const Transform &other) const;
+    operator==(const BasicTransform &other) const;
+
+    // Swap this Transform with another of the same precision. If either is frozen, its
+    // BasicTransformBake follows its state to the other, as when a std::vector of baked
+    // Transforms reallocates.
+    void
+    swap(BasicTransform &other) noexcept;
 
     // Swap two Transforms
     friend void
-    swap(Transform &first, Transform &second) noexcept;
+    swap(BasicTransform &first, BasicTransform &second) noexcept {
+        first.swap(second);
+    }
 
     /* Setters */
 
@@ -158,132 +306,410 @@ public:
      * @throws std::invalid_argument if setting this parent would create a cycle in the Transform
      *         hierarchy
      */
-    Transform &
-    setParent(Transform *parent, bool preserveLocalSpace = false);
+    BasicTransform &
+    setParent(BasicTransform *parent, bool preserveLocalSpace = false);
 
     // Set the Transform's world-space position.
-    Transform &
-    setPosition(glm::dvec3 position);
+    BasicTransform &
+    setPosition(Vec3 position);
 
     // Set the Transform's local position relative to its parent.
-    Transform &
-    setLocalPosition(glm::dvec3 localPosition);
+    BasicTransform &
+    setLocalPosition(Vec3 localPosition);
 
     // Set the Transform's world-space rotation.
-    Transform &
-    setRotation(glm::dquat rotation);
+    BasicTransform &
+    setRotation(Quat rotation);
 
     // Set the Transform's local rotation relative to its parent.
-    Transform &
-    setLocalRotation(glm::dquat localRotation);
+    BasicTransform &
+    setLocalRotation(Quat localRotation);
 
     // Set the Transform's world-space scale.
-    Transform &
-    setScale(glm::dvec3 scale);
+    BasicTransform &
+    setScale(Vec3 scale);
 
     // Set the Transform's local scale relative to its parent.
-    Transform &
-    setLocalScale(glm::dvec3 localScale);
+    BasicTransform &
+    setLocalScale(Vec3 localScale);
 
     // Set the Transform's world-space skew.
-    Transform &
-    setSkew(glm::dvec3 skew);
+    BasicTransform &
+    setSkew(Vec3 skew);
 
     // Set the Transform's local skew relative to its parent.
-    Transform &
-    setLocalSkew(glm::dvec3 localSkew);
+    BasicTransform &
+    setLocalSkew(Vec3 localSkew);
 
     /* Getters */
 
     // Get this Transform's parent if it has one, or nullptr if not.
-    [[nodiscard]] Transform *
+    [[nodiscard]] BasicTransform *
     parent() const;
 
+    // Get this Transform's most recently added child, or nullptr if it has none. The remaining
+    // children can be visited by following nextSibling().
+    [[nodiscard]] BasicTransform *
+    firstChild() const;
+
+    // Get the next child of this Transform's parent, or nullptr if this is the last one.
+    [[nodiscard]] BasicTransform *
+    nextSibling() const;
+
     // Get this Transform's world-space position.
-    [[nodiscard]] glm::dvec3
+    [[nodiscard]] Vec3
     position() const;
 
     // Get this Transform's local-space position.
-    [[nodiscard]] glm::dvec3
+    [[nodiscard]] Vec3
     localPosition() const;
 
     // Get this Transform's world-space rotation.
-    [[nodiscard]] glm::dquat
+    [[nodiscard]] Quat
     rotation() const;
 
     // Get this Transform's local-space rotation.
-    [[nodiscard]] glm::dquat
+    [[nodiscard]] Quat
     localRotation() const;
 
     // Get this Transform's world-space scale.
-    [[nodiscard]] glm::dvec3
+    [[nodiscard]] Vec3
     scale() const;
 
     // Get this Transform's local-space scale.
-    [[nodiscard]] glm::dvec3
+    [[nodiscard]] Vec3
     localScale() const;
 
     // Get this Transform's world-space skew.
-    [[nodiscard]] glm::dvec3
+    [[nodiscard]] Vec3
     skew() const;
 
     // Get this Transform's local-space skew.
-    [[nodiscard]] glm::dvec3
+    [[nodiscard]] Vec3
     localSkew() const;
 
     // Get the vector pointing right relative to this Transform's local-space. This is only based on
     // the Transform's rotation, not its position, scale or skew.
-    [[nodiscard]] glm::dvec3
+    [[nodiscard]] Vec3
     right() const;
 
     // Get the vector pointing up relative to this Transform's local-space. This is only based on
     // the Transform's rotation, not its position, scale or skew.
-    [[nodiscard]] glm::dvec3
+    [[nodiscard]] Vec3
     up() const;
 
     // Get the vector pointing forward relative to this Transform's local-space. This is only based
     // on the Transform's rotation, not its position, scale or skew. Note: because this uses a
     // right-handed coordinate system, this points in the negative direction along the z-axis
-    [[nodiscard]] glm::dvec3
+    [[nodiscard]] Vec3
     forward() const;
 
     // Get the matrix transforming from this Transform's parent's local-space to this Transform's
     // local-space.
-    [[nodiscard]] glm::dmat4
+    [[nodiscard]] Mat4
     parentToLocalMatrix() const;
 
     // Get the matrix transforming from this Transform's local-space to this Transform's parent's
     // local-space.
-    [[nodiscard]] glm::dmat4
+    [[nodiscard]] Mat4
     localToParentMatrix() const;
 
     // Get the matrix transforming from world-space to this Transform's local-space.
-    [[nodiscard]] glm::dmat4
+    [[nodiscard]] Mat4
     worldToLocalMatrix() const;
 
     // Get the matrix transforming from this Transform's local-space to world-space.
-    [[nodiscard]] glm::dmat4
+    [[nodiscard]] Mat4
     localToWorldMatrix() const;
 
+    // Get a counter that advances whenever this Transform's world-space data may have changed,
+    // whether through its own setters or any of its ancestors'. Anything derived from the world
+    // matrix can be kept until the counter moves on from the value it was derived at.
+    [[nodiscard]] std::uint64_t
+    worldGeneration() const;
+
+    /* Batch transformations */
+
+    /**
+     * Transform many points from this Transform's local-space to world-space. Equivalent to
+     * multiplying each point by localToWorldMatrix(), but the matrix is only fetched once, and
+     * as many points are transformed per step as fit in the widest available SIMD registers.
+     * @param points the local-space points
+     * @param out receives the world-space points. May be the same span as points.
+     * @throws std::invalid_argument if points and out are different sizes
+     */
+    void
+    transformPoints(std::span<const Vec3> points, std::span<Vec3> out) const;
+
+    /**
+     * Transform many directions from this Transform's local-space to world-space. Unlike points,
+     * directions are unaffected by translation, but they are still rotated, scaled, and skewed.
+     * Vectorized in the same way as transformPoints().
+     * @param directions the local-space directions
+     * @param out receives the world-space directions. May be the same span as directions.
+     * @throws std::invalid_argument if directions and out are different sizes
+     */
+    void
+    transformDirections(std::span<const Vec3> directions, std::span<Vec3> out) const;
+
+    /**
+     * Transform many points from world-space to this Transform's local-space, using
+     * worldToLocalMatrix(). Vectorized in the same way as transformPoints().
+     * @param points the world-space points
+     * @param out receives the local-space points. May be the same span as points.
+     * @throws std::invalid_argument if points and out are different sizes
+     */
+    void
+    inverseTransformPoints(std::span<const Vec3> points, std::span<Vec3> out) const;
+
+    /* Bounding volumes */
+
+    // A sphere, used to bound whatever is drawn at a Transform and its descendants.
+    struct Sphere {
+        Vec3 center{0, 0, 0};
+        T    radius{0};
+    };
+
+    /**
+     * Set the bounds of whatever is attached to this Transform, such as a mesh. Transforms without
+     * bounds of their own still group the bounds of their descendants.
+     * @param bounds a sphere in this Transform's local-space, or nullopt if nothing is attached
+     * @return a reference to this Transform
+     */
+    BasicTransform &
+    setLocalBounds(std::optional<Sphere> bounds);
+
+    // Get the bounds set by setLocalBounds(), in this Transform's local-space.
+    [[nodiscard]] std::optional<Sphere>
+    localBounds() const;
+
+    /**
+     * Get a world-space sphere enclosing the bounds of this Transform and all of its descendants.
+     * The sphere is cached alongside the world matrix and discarded with it, and a change anywhere
+     * in the subtree also discards the spheres of every ancestor above the change, so refreshing
+     * it only revisits the branches that changed.
+     * @return the sphere, or nullopt if nothing in the subtree has bounds
+     */
+    [[nodiscard]] std::optional<Sphere>
+    subtreeBounds() const;
+
+    /**
+     * Find every Transform in this subtree whose bounds intersect a frustum. Each subtree is first
+     * tested as a whole against its subtreeBounds(), so a branch entirely outside the frustum is
+     * rejected with a single test, and one entirely inside is accepted without testing any of its
+     * descendants. Runs without recursion, so hierarchies of any depth are safe.
+     * @param frustum the frustum to test against, e.g. Camera::frustum()
+     * @param visible cleared, then filled with every visible Transform that has local bounds
+     * @param origin the world-space point that sits at (0, 0, 0) in the frustum's space, e.g.
+     *        Camera::getOrigin()
+     */
+    void
+    cull(const Frustum                       &frustum,
+         std::vector<const BasicTransform *> &visible,
+         Vec3                                 origin = Vec3(0)) const;
+
+    /* Batch updates */
+
+    /**
+     * Bring the cached local-to-world matrix of this Transform and every one of its descendants up
+     * to date, without waiting for each to be read. Calling this on a root once per frame, after
+     * all setters have run, means that later calls to localToWorldMatrix() anywhere in its tree
+     * only read from the cache. Those reads are then safe to make from multiple threads at once,
+     * until the next setter is called. The other world-space getters still fill their own caches
+     * lazily and are not safe to call concurrently.
+     */
+    void
+    updateWorldMatrices() const;
+
+    /**
+     * Same as updateWorldMatrices(), but with independent subtrees split into tasks and updated in
+     * parallel on the given pool. Every matrix is computed with the same operations as the serial
+     * version, so the results are identical. The calling thread helps run tasks until the update
+     * is done. No setters may be called anywhere in the tree while the update is running.
+     * @param pool the pool to run the update on
+     */
+    void
+    updateWorldMatrices(ThreadPool &pool) const;
+
+    /**
+     * Freeze this Transform and all of its descendants, and compute their world matrices once
+     * into a compact array. The hierarchy stays frozen until the returned bake is destroyed or
+     * unfrozen.
+     * @throws std::invalid_argument if this Transform has a parent
+     * @throws std::logic_error if any Transform in the hierarchy is already frozen
+     */
+    [[nodiscard]] BasicTransformBake<T>
+    bake();
+
+    // Returns true if this Transform is frozen by a BasicTransformBake, in which case its setters
+    // throw std::logic_error.
+    [[nodiscard]] bool
+    frozen() const;
+
 private:
-    Transform                        *parent_{nullptr};
-    std::list<Transform *>::iterator  parentIt_{};
-    std::list<Transform *>            children_{};
+    // Children are kept in an intrusive doubly-linked list threaded through the siblings
+    // themselves, so linking and unlinking never allocates.
+    BasicTransform                   *parent_{nullptr};
+    BasicTransform                   *firstChild_{nullptr};
+    BasicTransform                   *prevSibling_{nullptr};
+    BasicTransform                   *nextSibling_{nullptr};
     Properties                        locals_;
-    mutable std::optional<glm::dmat4> cachedLocalToWorld_{};
-    mutable std::optional<glm::dmat4> cachedWorldToLocal_{};
-    mutable std::optional<Properties> cachedWorldProps_{};
+    // World-space data derived from the hierarchy. Most of a Transform's size would be spent on
+    // these, so they live in a separate allocation, made the first time any of them is cached and
+    // kept until the Transform is destroyed. This keeps traversals and setters, which only touch
+    // links and local properties, from pulling several cache lines of matrices in with each node.
+    // What remains is two 64-byte cache lines for a TransformF, but nearly three for a Transform,
+    // whose local properties alone take 104 bytes in double precision.
+    // The local bounds are rarely set, so they are kept here too, but aren't derived from anything:
+    // they survive invalidation, and copying a Transform copies them explicitly. So is the bake
+    // that froze this Transform, which always has a cache by then, and this Transform's index in
+    // it.
+    struct Cache {
+        std::optional<Mat4>       localToWorld;
+        std::optional<Mat4>       worldToLocal;
+        std::optional<Properties> worldProps;
+        // Cached as a negative radius if nothing in the subtree has bounds.
+        std::optional<Sphere>  subtreeBounds;
+        std::optional<Sphere>  localBounds;
+        BasicTransformBake<T> *bake{nullptr};
+        std::size_t            bakeSlot{0};
+    };
+    mutable std::unique_ptr<Cache> cache_;
+    // Incremented whenever this Transform's cached world-space data is discarded, so that
+    // descendants can tell that anything they derived from it is out of date.
+    mutable std::uint64_t generation_{0};
+    // The parent's generation_ at the time this Transform's caches were last validated.
+    mutable std::uint64_t parentGeneration_{0};
+    // The journal that records changes to this Transform, if any, and this Transform's entry in
+    // it.
+    BasicTransformJournal<T> *journal_{nullptr};
+    std::uint32_t             journalSlot_{0};
+    // Set while a BasicTransformBake holds this Transform's world matrix. The bake itself is kept
+    // in the cache, since it is only needed when this Transform is destroyed.
+    bool frozen_{false};
 
 private:
-    Transform(Transform *parent, Properties properties);
+    friend class BasicTransformJournal<T>;
+    friend class BasicTransformBake<T>;
+
+    BasicTransform(BasicTransform *parent, Properties properties);
+
+    // Link a child into the front of this Transform's list of children.
+    void
+    addChild(BasicTransform *child);
 
-    // Add a child to this Transform's children list, and store the resulting iterator in the
-    // child's parentIt_ member.
+    // Unlink a child from this Transform's list of children.
     void
-    addChild(Transform *child);
+    removeChild(BasicTransform *child);
 
-    // Clear all of this Transform's cached parameters, then invoke this method on all of its
-    // children recursively.
+    // Clear all of this Transform's cached parameters and advance its generation. Descendants are
+    // not visited; they notice the new generation the next time they validate their own caches.
     void
     invalidateCache() const;
+
+    // Invalidate this Transform's caches after one of its own properties or its parent has been
+    // set, and record the change in its journal, if it has one. Changes that only propagate from
+    // an ancestor go through invalidateCache() instead; the journal finds those itself.
+    void
+    markChanged();
+
+    // Discard the cached subtree bounds of this Transform and all of its ancestors, after anything
+    // that they enclose has changed.
+    void
+    invalidateBounds() const;
+
+    // Throw std::logic_error if this Transform is frozen. Called by every setter before it makes
+    // any change.
+    void
+    checkNotFrozen() const;
+
+    // Exchange journal entries with another Transform, pointing each entry at its new owner.
+    void
+    swapJournals(BasicTransform &other) noexcept;
+
+    // Get this Transform's caches, allocating them empty if they haven't been yet.
+    Cache &
+    cache() const;
+
+    // Bring this Transform's caches up to date with its ancestors, discarding any that were built
+    // from an older generation of its parent. Must be called before reading any cached
+    // world-space value.
+    void
+    validateCache() const;
+
+    // Refresh this Transform's cached local-to-world matrix from its parent's, which must already
+    // be up to date. Unlike validateCache(), this never visits any ancestors.
+    void
+    updateFromParent() const;
+
+    // Get the local-to-world matrix, computing and caching it if necessary. Assumes validateCache()
+    // has already been called.
+    const Mat4 &
+    cachedLocalToWorld() const;
+
+    // Get the world-to-local matrix, inverting and caching the local-to-world matrix if
+    // necessary. Assumes validateCache() has already been called.
+    const Mat4 &
+    cachedWorldToLocal() const;
+
+    // Get the world-space properties, computing and caching them if necessary. Assumes
+    // validateCache() has already been called.
+    const Properties &
+    cachedWorldProps() const;
+
+    // Get the subtree bounds, computing and caching them for this Transform and any descendants
+    // whose bounds have been discarded. Assumes validateCache() has already been called.
+    const Sphere &
+    cachedSubtreeBounds() const;
+
+    // Get this Transform's local bounds in world-space, or nullopt if it has none. Assumes
+    // validateCache() has already been called.
+    std::optional<Sphere>
+    worldBounds() const;
+
+    // Make sure the world-space properties are cached, composing them from the parent's with
+    // quaternion math if the parent is a similarity, so that no matrix has to be decomposed.
+    // Returns false, leaving the cache empty, if they could only be found by decomposing the world
+    // matrix. Assumes validateCache() has already been called.
+    bool
+    composeWorldProps() const;
+
+    // Get the local properties that place a Transform at the given world-space properties beneath
+    // a parent whose world-space properties form the given similarity.
+    static Properties
+    relativeToSimilarity(const Properties &similarity, const Properties &world);
+
+    // Get the local properties that would keep this Transform fixed in world space beneath the
+    // given parent, or beneath nothing if parent is nullptr.
+    Properties
+    localPropertiesUnder(const BasicTransform *parent) const;
+
+    // Get the parent's world-space properties if its world transformation is a similarity, i.e.
+    // it has uniform positive scale and no skew, or identity properties if there is no parent.
+    // Returns nullopt otherwise. Under a similarity, world rotation, scale, and skew map directly
+    // onto local ones, so the world-space setters can skip decomposing matrices. Assumes
+    // validateCache() has already been called.
+    std::optional<Properties>
+    parentSimilarity() const;
+
+    // Same as parentSimilarity(), but for any Transform, or nullptr for identity properties.
+    // Assumes validateCache() has already been called on the Transform.
+    static std::optional<Properties>
+    similarityOf(const BasicTransform *transform);
+
+    // Set one of this Transform's world-space properties by decomposing its world matrix,
+    // replacing the property, and decomposing the result relative to the parent. Used by the
+    // world-space setters when the parent is not a similarity.
+    template<typename V>
+    BasicTransform &
+    setWorldProperty(V Properties::*member, V value);
 };
+
+extern template class BasicTransform<float>;
+extern template class BasicTransform<double>;
+
+// Double-precision Transform, for simulated objects and anything that may be far from the origin.
+using Transform = BasicTransform<double>;
+
+// Single-precision Transform, for render-only objects such as particles and decorations.
+using TransformF = BasicTransform<float>;
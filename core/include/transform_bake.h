@@ -0,0 +1,87 @@
+//
+// Created by taylor-santos on 10/17/2026 at 02:14.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "transform.h"
+
+/***
+ * The world matrices of a static hierarchy, such as a level's walls and props, computed once and
+ * stored in a compact read-only array that renderers and culling can consume directly. Every
+ * Transform in the hierarchy is frozen for as long as it is baked: its setters throw instead of
+ * invalidating the baked matrices. Moving or swapping a frozen Transform moves it within the bake
+ * along with its state, and destroying one removes it from the bake and detaches its children in
+ * place as usual. Destroying the bake or calling unfreeze() thaws the hierarchy again.
+ * Transforms attached beneath a baked hierarchy afterwards are neither baked nor frozen.
+ */
+template<typename T>
+class BasicTransformBake {
+public:
+    using Transform = BasicTransform<T>;
+    using Mat4      = typename Transform::Mat4;
+
+    // An empty bake, which freezes nothing.
+    BasicTransformBake() = default;
+
+    /**
+     * Freeze a root Transform and all of its descendants, and compute their world matrices.
+     * @param root the root of the hierarchy to bake
+     * @throws std::invalid_argument if root has a parent, since the parent could still move it
+     * @throws std::logic_error if any Transform in the hierarchy is already frozen, in which case
+     *         nothing is frozen
+     */
+    explicit BasicTransformBake(Transform &root);
+
+    // Thaw every Transform that is still frozen by this bake.
+    ~BasicTransformBake();
+
+    // The moved-from bake is left empty, and the Transforms stay frozen by the new one.
+    BasicTransformBake(BasicTransformBake &&other) noexcept;
+    BasicTransformBake &
+    operator=(BasicTransformBake &&other) noexcept;
+
+    BasicTransformBake(const BasicTransformBake &) = delete;
+    BasicTransformBake &
+    operator=(const BasicTransformBake &) = delete;
+
+    // Get the world matrix of every baked Transform, in the same order as transforms().
+    [[nodiscard]] std::span<const Mat4>
+    matrices() const;
+
+    // Get every baked Transform, with each parent before its children until one of them is
+    // destroyed, which moves the last Transform into its place.
+    [[nodiscard]] std::span<Transform *const>
+    transforms() const;
+
+    // Get the number of baked Transforms.
+    [[nodiscard]] std::size_t
+    size() const;
+
+    // Thaw every baked Transform and empty the bake, so that the hierarchy can be changed again.
+    void
+    unfreeze();
+
+private:
+    friend class BasicTransform<T>;
+
+    std::vector<Transform *> transforms_;
+    std::vector<Mat4>        matrices_;
+
+    // Remove a Transform that is being destroyed, moving the last one into its place.
+    void
+    forget(const Transform *transform);
+};
+
+extern template class BasicTransformBake<float>;
+extern template class BasicTransformBake<double>;
+
+// A bake of double-precision Transforms.
+using TransformBake = BasicTransformBake<double>;
+
+// A bake of single-precision Transforms.
+using TransformBakeF = BasicTransformBake<float>;
@@ -0,0 +1,298 @@
+//
+// Created by taylor-santos on 10/16/2026 at 19:52.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "transform.h"
+
+/***
+ * A structure-of-arrays container for large Transform hierarchies. Local properties, parent
+ * indices, and world matrices are each stored in their own contiguous array, sorted so that every
+ * parent precedes all of its children. This allows updateWorldMatrices() to refresh every world
+ * matrix in a single linear pass instead of chasing parent pointers one node at a time.
+ * Nodes are identified by stable IDs that survive reordering of the underlying arrays. A View
+ * wraps one of these IDs and exposes the same API as a standalone Transform.
+ */
+class TransformHierarchy {
+public:
+    using Id = std::uint32_t;
+
+    // Sentinel used for "no node", e.g. the parent of a root node.
+    static constexpr Id NONE = ~Id{0};
+
+    /***
+     * A lightweight handle to a single node in a TransformHierarchy, providing the same getters
+     * and setters as a Transform. Views are cheap to copy and remain valid until their node is
+     * destroyed, regardless of how the hierarchy reorders its storage. A default-constructed View
+     * refers to no node, and is used in place of a nullptr parent.
+     */
+    class View {
+    public:
+        View() = default;
+
+        // Get the stable ID of the node this View refers to.
+        [[nodiscard]] Id
+        id() const;
+
+        // Returns true if this View refers to a node.
+        explicit operator bool() const;
+
+        // Two Views are equal if they refer to the same node of the same hierarchy.
+        bool
+        operator==(const View &other) const;
+
+        /* Setters */
+
+        /**
+         * Set the node's parent, or remove its parent if a default-constructed View is given.
+         * Follows the same rules as Transform::setParent().
+         * @param parent the new parent, which must belong to the same hierarchy
+         * @param preserveLocalSpace whether to keep local (true) or world (false) characteristics
+         *        fixed
+         * @return a reference to this View, so setters may be chained
+         * @throws std::invalid_argument if setting this parent would create a cycle, or if the
+         *         parent belongs to a different hierarchy
+         */
+        View &
+        setParent(View parent, bool preserveLocalSpace = false);
+
+        // Set the node's world-space position.
+        View &
+        setPosition(glm::dvec3 position);
+
+        // Set the node's local position relative to its parent.
+        View &
+        setLocalPosition(glm::dvec3 localPosition);
+
+        // Set the node's world-space rotation.
+        View &
+        setRotation(glm::dquat rotation);
+
+        // Set the node's local rotation relative to its parent.
+        View &
+        setLocalRotation(glm::dquat localRotation);
+
+        // Set the node's world-space scale.
+        View &
+        setScale(glm::dvec3 scale);
+
+        // Set the node's local scale relative to its parent.
+        View &
+        setLocalScale(glm::dvec3 localScale);
+
+        // Set the node's world-space skew.
+        View &
+        setSkew(glm::dvec3 skew);
+
+        // Set the node's local skew relative to its parent.
+        View &
+        setLocalSkew(glm::dvec3 localSkew);
+
+        /* Getters */
+
+        // Get this node's parent, or a default-constructed View if it is a root.
+        [[nodiscard]] View
+        parent() const;
+
+        // Get this node's world-space position.
+        [[nodiscard]] glm::dvec3
+        position() const;
+
+        // Get this node's local-space position.
+        [[nodiscard]] glm::dvec3
+        localPosition() const;
+
+        // Get this node's world-space rotation.
+        [[nodiscard]] glm::dquat
+        rotation() const;
+
+        // Get this node's local-space rotation.
+        [[nodiscard]] glm::dquat
+        localRotation() const;
+
+        // Get this node's world-space scale.
+        [[nodiscard]] glm::dvec3
+        scale() const;
+
+        // Get this node's local-space scale.
+        [[nodiscard]] glm::dvec3
+        localScale() const;
+
+        // Get this node's world-space skew.
+        [[nodiscard]] glm::dvec3
+        skew() const;
+
+        // Get this node's local-space skew.
+        [[nodiscard]] glm::dvec3
+        localSkew() const;
+
+        // Get the vector pointing right relative to this node's local-space.
+        [[nodiscard]] glm::dvec3
+        right() const;
+
+        // Get the vector pointing up relative to this node's local-space.
+        [[nodiscard]] glm::dvec3
+        up() const;
+
+        // Get the vector pointing forward relative to this node's local-space.
+        [[nodiscard]] glm::dvec3
+        forward() const;
+
+        // Get the matrix transforming from this node's parent's local-space to its local-space.
+        [[nodiscard]] glm::dmat4
+        parentToLocalMatrix() const;
+
+        // Get the matrix transforming from this node's local-space to its parent's local-space.
+        [[nodiscard]] glm::dmat4
+        localToParentMatrix() const;
+
+        // Get the matrix transforming from world-space to this node's local-space.
+        [[nodiscard]] glm::dmat4
+        worldToLocalMatrix() const;
+
+        // Get the matrix transforming from this node's local-space to world-space.
+        [[nodiscard]] glm::dmat4
+        localToWorldMatrix() const;
+
+    private:
+        TransformHierarchy *hierarchy_{nullptr};
+        Id                  id_{NONE};
+
+    private:
+        friend class TransformHierarchy;
+
+        View(TransformHierarchy *hierarchy, Id id);
+
+        // Get this node's current position in the hierarchy's arrays.
+        [[nodiscard]] std::uint32_t
+        index() const;
+
+        // Set one of this node's world-space properties, then copy the corresponding local-space
+        // property back into the node.
+        template<typename T>
+        View &
+        setWorld(T Transform::Properties::*member, T value);
+    };
+
+    TransformHierarchy() = default;
+
+    // Views hold a pointer to their hierarchy, so it must not be copied or moved out from under
+    // them.
+    TransformHierarchy(const TransformHierarchy &) = delete;
+    TransformHierarchy &
+    operator=(const TransformHierarchy &) = delete;
+
+    /**
+     * Create a new root node with the given local properties.
+     * @param locals the new node's translation, rotation, scale, and skew
+     * @return a View of the new node
+     */
+    View
+    create(const Transform::Properties &locals = {});
+
+    /**
+     * Create a new node as a child of parent, with the given local properties.
+     * @param parent the new node's parent, or a default-constructed View for a root node
+     * @param locals the new node's translation, rotation, scale, and skew relative to its parent
+     * @return a View of the new node
+     * @throws std::invalid_argument if the parent belongs to a different hierarchy
+     */
+    View
+    create(View parent, const Transform::Properties &locals = {});
+
+    /**
+     * Destroy a node. Like a Transform's destructor, any children of the node have their parent
+     * removed and their local properties readjusted so that they stay fixed in world space. This
+     * shifts the storage of every node after it, and so is O(n) in the size of the hierarchy.
+     * Destroying many nodes one at a time is therefore quadratic, so tear down a whole hierarchy
+     * with clear() instead.
+     * @param node the node to destroy. Its ID may be reused by later calls to create().
+     */
+    void
+    destroy(View node);
+
+    // Destroy every node at once. Every existing View is invalidated, and IDs may be reused by
+    // later calls to create().
+    void
+    clear();
+
+    /**
+     * Get a View of the node with the given ID.
+     * @throws std::out_of_range if no node has the given ID
+     */
+    [[nodiscard]] View
+    get(Id id);
+
+    // Returns true if a node with the given ID exists in this hierarchy.
+    [[nodiscard]] bool
+    contains(Id id) const;
+
+    // Get the number of nodes in the hierarchy.
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * Bring every world matrix up to date in a single pass over the hierarchy. Nodes whose local
+     * properties have not changed, and whose ancestors have not changed, are skipped. If any node
+     * was reparented beneath a node that follows it in storage, the arrays are first re-sorted so
+     * that parents precede their children.
+     */
+    void
+    updateWorldMatrices();
+
+    /**
+     * Get the world matrices of every node, in storage order. Calls updateWorldMatrices() first,
+     * so the result is always current. The ID of the node at each position is given by
+     * order()[i].
+     */
+    [[nodiscard]] const std::vector<glm::dmat4> &
+    worldMatrices();
+
+    /**
+     * Get the ID of each node in storage order. Calls updateWorldMatrices() first, so the order
+     * matches that of worldMatrices().
+     */
+    [[nodiscard]] const std::vector<Id> &
+    order();
+
+private:
+    // Per-node arrays, indexed by storage position. Parents always precede their children unless
+    // unsorted_ is set.
+    std::vector<Transform::Properties> locals_;
+    std::vector<std::uint32_t>         parents_;
+    std::vector<glm::dmat4>            worlds_;
+    std::vector<std::uint8_t>          dirty_;
+    std::vector<Id>                    ids_;
+
+    // Maps each ID to its node's storage position, or NONE if the ID is unused.
+    std::vector<std::uint32_t> indices_;
+    std::vector<Id>            freeIds_;
+
+    // Scratch space for updateWorldMatrices(), kept between calls to avoid reallocating.
+    std::vector<std::uint32_t>         dirtyIndices_;
+    std::vector<Transform::Properties> dirtyLocals_;
+    std::vector<glm::dmat4>            dirtyMats_;
+
+    // Set when a node has been reparented beneath a node that follows it in storage.
+    bool unsorted_{false};
+    // Set when any node's world matrix is out of date.
+    bool pending_{false};
+
+private:
+    // Mark the node at the given storage position as changed.
+    void
+    markDirty(std::uint32_t index);
+
+    // Compute the current world matrix of the node at the given storage position, without
+    // modifying any stored matrices.
+    [[nodiscard]] glm::dmat4
+    worldMatrix(std::uint32_t index) const;
+
+    // Stable-sort the per-node arrays by depth so that every parent precedes its children.
+    void
+    sort();
+};
@@ -0,0 +1,69 @@
+//
+// Created by taylor-santos on 10/17/2026 at 10:20.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "transform.h"
+
+/***
+ * Smooths the motion of Transforms that are simulated at a fixed rate (see FixedTimestep) but
+ * rendered at any rate. After each simulation step, capture() records the world-space properties
+ * of a list of Transforms, keeping the previous step's as well. interpolate() then blends the two
+ * for a frame that falls between the steps. Blending decomposed properties rather than matrices
+ * keeps each rotation rigid: positions, scales, and skews are interpolated linearly, and
+ * rotations with slerp. Every Transform is blended in world space on its own, so a child that
+ * swings around a turning parent moves along a straight line between steps rather than an arc.
+ * The interpolated frame trails the simulation by up to one step.
+ */
+template<typename T>
+class BasicTransformInterpolation {
+public:
+    using Transform  = BasicTransform<T>;
+    using Mat4       = typename Transform::Mat4;
+    using Properties = typename Transform::Properties;
+
+    BasicTransformInterpolation() = default;
+
+    /**
+     * Record the world-space properties of the given Transforms as the current state, and make
+     * the previously current state the previous one. If the number of Transforms differs from the
+     * last capture, there is nothing to interpolate from, so both states are set to the new one.
+     * @param transforms the Transforms to record, in the order their matrices will be output
+     */
+    void
+    capture(std::span<const Transform *const> transforms);
+
+    /**
+     * Blend the previous and current states into world matrices.
+     * @param alpha how far to go from the previous state (0) to the current state (1), usually
+     *        FixedTimestep::alpha()
+     * @param out receives one matrix per captured Transform
+     * @throws std::invalid_argument if out is not the same size as the last capture
+     */
+    void
+    interpolate(T alpha, std::span<Mat4> out);
+
+    // Get the number of Transforms in the last capture.
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    std::vector<Properties> previous_;
+    std::vector<Properties> current_;
+    // Scratch space for the blended properties, reused between frames.
+    std::vector<Properties> blended_;
+};
+
+extern template class BasicTransformInterpolation<float>;
+extern template class BasicTransformInterpolation<double>;
+
+// Interpolation between states of double-precision Transforms.
+using TransformInterpolation = BasicTransformInterpolation<double>;
+
+// Interpolation between states of single-precision Transforms.
+using TransformInterpolationF = BasicTransformInterpolation<float>;
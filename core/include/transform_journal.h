@@ -0,0 +1,116 @@
+//
+// Created by taylor-santos on 10/17/2026 at 00:52.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "transform.h"
+
+/***
+ * Records which Transforms have changed since the last call to flush(), so that a renderer can
+ * re-upload only the world matrices that actually moved. Each tracked Transform may be given an ID,
+ * such as the index of its instance in a GPU buffer, and flush() reports the IDs whose world
+ * matrices may have changed.
+ * Setters record only the Transform they were called on. flush() then expands each of those into
+ * its whole subtree, since moving a Transform moves all of its descendants, so nothing is done per
+ * descendant until the journal is flushed. Only tracked Transforms record changes, so every
+ * Transform that can move must be tracked for the changes to reach its descendants, even if it has
+ * no ID of its own.
+ * The demo application doesn't currently use a journal: its cubes are interpolated between
+ * simulation steps and frustum-culled into a compacted buffer, so every visible matrix is uploaded
+ * every frame anyway. A journal pays off for instances that are drawn at their simulated state and
+ * stay at fixed offsets in an instance buffer, such as static or rarely moving scenery.
+ */
+template<typename T>
+class BasicTransformJournal {
+public:
+    using Transform = BasicTransform<T>;
+    using Id        = std::uint32_t;
+
+    // The ID of a Transform that is tracked only so that its changes reach its descendants.
+    static constexpr Id NONE = ~Id{0};
+
+    BasicTransformJournal() = default;
+
+    // Stop tracking every Transform that is still tracked.
+    ~BasicTransformJournal();
+
+    // Tracked Transforms point back at their journal, so it must not be copied or moved out from
+    // under them.
+    BasicTransformJournal(const BasicTransformJournal &) = delete;
+    BasicTransformJournal &
+    operator=(const BasicTransformJournal &) = delete;
+
+    /**
+     * Start tracking a Transform. It counts as changed at the next flush(), so that its initial
+     * world matrix is reported. The journal stops tracking it when it is destroyed. Tracking
+     * follows the Transform if it is moved or swapped.
+     * @param transform the Transform to track
+     * @param id the ID to report for this Transform, or NONE to track it without reporting it
+     * @throws std::invalid_argument if the Transform is already tracked by a journal
+     */
+    void
+    track(Transform &transform, Id id = NONE);
+
+    /**
+     * Stop tracking a Transform. Any change recorded for it that has not yet been flushed is
+     * discarded.
+     * @throws std::invalid_argument if the Transform is not tracked by this journal
+     */
+    void
+    untrack(Transform &transform);
+
+    // Get the number of Transforms being tracked.
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * Get the ID of every tracked Transform whose world matrix may have changed since the last
+     * flush(): those that were changed directly, along with their tracked descendants. Each ID
+     * appears once, in no particular order. Transforms tracked with NONE are never reported.
+     * @return the changed IDs, which remain valid until the next call to flush()
+     */
+    [[nodiscard]] std::span<const Id>
+    flush();
+
+private:
+    struct Entry {
+        Transform *transform;
+        Id         id;
+        // The value of flushes_ when this entry was last recorded as changed, and when it was
+        // last reached while expanding changes, so that each happens at most once per flush.
+        std::uint64_t recorded;
+        std::uint64_t visited;
+    };
+
+    std::vector<Entry>         entries_;
+    std::vector<std::uint32_t> freeEntries_;
+    // Entries recorded as changed since the last flush.
+    std::vector<std::uint32_t> changed_;
+    // Starts at 1 so that new entries, with recorded = 0, are never considered recorded.
+    std::uint64_t flushes_{1};
+
+    // Scratch space for flush(), kept between calls to avoid reallocating.
+    std::vector<Id>                ids_;
+    std::vector<const Transform *> stack_;
+
+private:
+    friend class BasicTransform<T>;
+
+    // Record that the Transform with the given entry has changed.
+    void
+    record(std::uint32_t slot);
+};
+
+extern template class BasicTransformJournal<float>;
+extern template class BasicTransformJournal<double>;
+
+// A journal of double-precision Transforms.
+using TransformJournal = BasicTransformJournal<double>;
+
+// A journal of single-precision Transforms.
+using TransformJournalF = BasicTransformJournal<float>;
@@ -0,0 +1,203 @@
+//
+// Created by taylor-santos on 10/16/2026 at 23:41.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "transform.h"
+
+/***
+ * Owns a set of Transforms in chunked storage, referring to each by a generational Handle. A
+ * Transform's address never changes for as long as it lives in the pool, so unlike a
+ * std::vector<Transform>, growing, moving, or compacting the pool never has to rewrite any
+ * parent or sibling links, and raw pointers and references to the Transforms stay valid.
+ * Destroyed slots are reused by later calls to create(). Each slot counts how many times it has
+ * been reused, so a Handle to a destroyed Transform can never be mistaken for its replacement.
+ */
+template<typename T>
+class BasicTransformPool {
+public:
+    using Transform = BasicTransform<T>;
+
+    // The number of Transforms allocated at once whenever the pool runs out of free slots.
+    static constexpr std::size_t CHUNK_SIZE = 256;
+
+    /***
+     * A reference to a Transform in a BasicTransformPool. Handles are cheap to copy and compare,
+     * and are only valid for the pool that created them. A default-constructed Handle never refers
+     * to a Transform.
+     */
+    class Handle {
+    public:
+        Handle() = default;
+
+        // Two Handles are equal if they refer to the same Transform.
+        bool
+        operator==(const Handle &other) const = default;
+
+    private:
+        friend class BasicTransformPool;
+
+        static constexpr std::uint32_t NONE = ~std::uint32_t{0};
+
+        std::uint32_t index_{NONE};
+        std::uint32_t generation_{0};
+
+    private:
+        Handle(std::uint32_t index, std::uint32_t generation);
+    };
+
+    BasicTransformPool() = default;
+
+    // Destroy every Transform in the pool. Transforms outside of the pool that are children of a
+    // pooled Transform are detached in the same way as by ~Transform().
+    ~BasicTransformPool();
+
+    // The Transforms themselves never move, so moving a pool only transfers its chunks.
+    BasicTransformPool(BasicTransformPool &&other) noexcept;
+    BasicTransformPool &
+    operator=(BasicTransformPool &&other) noexcept;
+
+    BasicTransformPool(const BasicTransformPool &) = delete;
+    BasicTransformPool &
+    operator=(const BasicTransformPool &) = delete;
+
+    /**
+     * Create a new Transform in the pool, allocating a new chunk if there are no free slots.
+     * @param builder the new Transform's parent and local properties. The parent may be any
+     *        Transform, whether or not it belongs to this pool.
+     * @return a Handle to the new Transform
+     */
+    Handle
+    create(const typename Transform::Builder &builder = {});
+
+    /**
+     * Destroy a Transform. Like ~Transform(), any children have their parent removed and their
+     * local properties readjusted so that they stay fixed in world space. Its slot may be reused
+     * by later calls to create(), but the Handle will never refer to the replacement.
+     * @throws std::out_of_range if the Handle does not refer to a Transform in this pool
+     */
+    void
+    destroy(Handle handle);
+
+    /**
+     * Destroy a Transform along with every descendant that belongs to this pool. Unlike calling
+     * destroy() on each of them, no Transform in the subtree is reparented on the way, so no
+     * matrices are decomposed. Descendants that don't belong to this pool are detached as if by
+     * ~Transform(), keeping them fixed in world space along with their own subtrees.
+     * @throws std::out_of_range if the Handle does not refer to a Transform in this pool
+     */
+    void
+    destroySubtree(Handle handle);
+
+    /**
+     * Get the Transform that a Handle refers to. The reference remains valid until the Transform
+     * is destroyed.
+     * @throws std::out_of_range if the Handle does not refer to a Transform in this pool
+     */
+    [[nodiscard]] Transform &
+    get(Handle handle);
+
+    /**
+     * Get the Transform that a Handle refers to. The reference remains valid until the Transform
+     * is destroyed.
+     * @throws std::out_of_range if the Handle does not refer to a Transform in this pool
+     */
+    [[nodiscard]] const Transform &
+    get(Handle handle) const;
+
+    // Get the Transform that a Handle refers to, or nullptr if it has been destroyed.
+    [[nodiscard]] Transform *
+    find(Handle handle);
+
+    // Get the Transform that a Handle refers to, or nullptr if it has been destroyed.
+    [[nodiscard]] const Transform *
+    find(Handle handle) const;
+
+    // Returns true if the Handle refers to a Transform in this pool.
+    [[nodiscard]] bool
+    contains(Handle handle) const;
+
+    // Get the number of Transforms in the pool.
+    [[nodiscard]] std::size_t
+    size() const;
+
+    // Get the number of Transforms the pool can hold before it must allocate another chunk.
+    [[nodiscard]] std::size_t
+    capacity() const;
+
+    /**
+     * Release every empty chunk at the end of the pool, and arrange for later calls to create()
+     * to fill the lowest free slots first, packing new Transforms into the front of the pool
+     * instead of scattering them over whichever slots were freed most recently. No Transform is
+     * moved, so all references and Handles remain valid.
+     */
+    void
+    compact();
+
+private:
+    // Raw storage for one Transform, which is constructed directly in place by create().
+    struct Slot {
+        alignas(Transform) std::byte storage[sizeof(Transform)];
+    };
+
+    using Chunk = std::unique_ptr<Slot[]>;
+
+    // The first slot of a chunk, and the index of that slot.
+    struct ChunkRange {
+        const Slot   *first;
+        std::uint32_t index;
+    };
+
+    std::vector<Chunk> chunks_;
+    // The generation of every slot, indexed by slot, which is odd while the slot holds a
+    // Transform and is incremented whenever one is created or destroyed. Kept even for released
+    // chunks, so that Handles into them stay invalid if the chunk is later reallocated.
+    std::vector<std::uint32_t> generations_;
+    // Free slots, in the reverse of the order that create() should use them.
+    std::vector<std::uint32_t> freeSlots_;
+    std::size_t                size_{0};
+
+private:
+    // Get the Transform in the slot at the given index, which must hold one.
+    [[nodiscard]] Transform *
+    node(std::uint32_t index) const;
+
+    // Returns true if the slot at the given index, which must be less than capacity(), holds a
+    // Transform.
+    [[nodiscard]] bool
+    occupied(std::uint32_t index) const;
+
+    // Get the index of the slot holding the given Transform, or nullopt if it isn't in this pool.
+    // The chunk ranges must be sorted by chunkRanges().
+    [[nodiscard]] std::optional<std::uint32_t>
+    indexOf(const Transform *transform, std::span<const ChunkRange> ranges) const;
+
+    // Get the address range of every chunk, sorted by address.
+    [[nodiscard]] std::vector<ChunkRange>
+    chunkRanges() const;
+
+    // Destroy the Transform in the slot at the given index, and free the slot.
+    void
+    release(std::uint32_t index);
+
+    // Destroy every Transform in the pool and release all chunks.
+    void
+    clear();
+};
+
+extern template class BasicTransformPool<float>;
+extern template class BasicTransformPool<double>;
+
+// A pool of double-precision Transforms.
+using TransformPool = BasicTransformPool<double>;
+
+// A pool of single-precision Transforms.
+using TransformPoolF = BasicTransformPool<float>;
@@ -0,0 +1,439 @@
+//
+// Created by taylor-santos on 10/17/2026 at 09:12.
+//
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
+
+#include "transform.h"
+
+/***
+ * A small constexpr counterpart to the glm types used by Transform, for prefabs whose layout is
+ * known at compile time, such as furniture arrangements and vault templates. glm's matrix and
+ * quaternion arithmetic can't run in constant expressions, so the types here are plain aggregates
+ * and every function is constexpr. flatten() turns a whole prefab hierarchy into world matrices
+ * during compilation, so it costs nothing at startup:
+ *
+ *     constexpr auto table = Prefab::flatten(std::array{
+ *         Prefab::Node<double>{Prefab::none, {.translation = {0, 0, 5}}},
+ *         Prefab::Node<double>{0, {.rotation = Prefab::angleAxis(0.5, {0, 1, 0})}},
+ *     });
+ *
+ * Transform's recompose(), recomposeInverse(), and decompose() are built on the same functions, so
+ * a flattened prefab matches the Transform hierarchy it describes.
+ * Square roots and trigonometry fall back to <cmath> when evaluated at runtime.
+ */
+namespace Prefab {
+
+template<typename T>
+struct Vec3 {
+    T x{0}, y{0}, z{0};
+};
+
+// Stored in the same order as glm's quaternion constructor, rather than glm's x, y, z, w layout.
+template<typename T>
+struct Quat {
+    T w{1}, x{0}, y{0}, z{0};
+};
+
+// Column-major, like glm: m[column][row].
+template<typename T>
+struct Mat3 {
+    std::array<std::array<T, 3>, 3> m{{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+};
+
+// Column-major, like glm: m[column][row].
+template<typename T>
+struct Mat4 {
+    std::array<std::array<T, 4>, 4> m{{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}}};
+};
+
+// The same properties as BasicTransform<T>::Properties.
+template<typename T>
+struct Properties {
+    Vec3<T> translation{0, 0, 0};
+    Quat<T> rotation{1, 0, 0, 0};
+    Vec3<T> scale{1, 1, 1};
+    Vec3<T> skew{0, 0, 0};
+};
+
+// The parent index of a Node at the root of a prefab.
+inline constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+
+// One Transform in a prefab: the index of its parent, or none, and its local properties.
+template<typename T>
+struct Node {
+    std::size_t   parent{none};
+    Properties<T> locals{};
+};
+
+template<typename T>
+constexpr T
+sqrt(T x) {
+    if (!std::is_constant_evaluated()) return std::sqrt(x);
+    if (x < 0 || x != x) return std::numeric_limits<T>::quiet_NaN();
+    if (x == 0 || x == std::numeric_limits<T>::infinity()) return x;
+    // Newton's method, starting above the root so that it converges from one side.
+    T guess = x > 1 ? x : T(1);
+    for (int i = 0; i < 1024; i++) {
+        T next = (guess + x / guess) / 2;
+        if (next >= guess) break;
+        guess = next;
+    }
+    return guess;
+}
+
+namespace detail {
+
+// Reduce x to [-pi, pi], then sum the Taylor series of sin or cos.
+template<typename T>
+constexpr T
+taylor(T x, bool cosine) {
+    constexpr T tau = 2 * std::numbers::pi_v<T>;
+    x -= tau * static_cast<T>(static_cast<long long>(x / tau));
+    if (x > std::numbers::pi_v<T>) x -= tau;
+    if (x < -std::numbers::pi_v<T>) x += tau;
+    T term = cosine ? T(1) : x;
+    T sum  = term;
+    for (int n = cosine ? 1 : 2; n < 64; n += 2) {
+        term *= -x * x / static_cast<T>(n * (n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+} // namespace detail
+
+template<typename T>
+constexpr T
+sin(T x) {
+    if (!std::is_constant_evaluated()) return std::sin(x);
+    return detail::taylor(x, false);
+}
+
+template<typename T>
+constexpr T
+cos(T x) {
+    if (!std::is_constant_evaluated()) return std::cos(x);
+    return detail::taylor(x, true);
+}
+
+template<typename T>
+constexpr Quat<T>
+operator*(const Quat<T> &a, const Quat<T> &b) {
+    return {
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+        a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x};
+}
+
+template<typename T>
+constexpr Quat<T>
+conjugate(const Quat<T> &q) {
+    return {q.w, -q.x, -q.y, -q.z};
+}
+
+template<typename T>
+constexpr Quat<T>
+normalize(const Quat<T> &q) {
+    T len = sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+    if (len <= 0) return {};
+    return {q.w / len, q.x / len, q.y / len, q.z / len};
+}
+
+// A rotation of angle radians about a unit axis, like glm::angleAxis().
+template<typename T>
+constexpr Quat<T>
+angleAxis(T angle, const Vec3<T> &axis) {
+    T s = sin(angle / 2);
+    return {cos(angle / 2), axis.x * s, axis.y * s, axis.z * s};
+}
+
+// The rotation matrix of a unit quaternion, like glm::toMat3().
+template<typename T>
+constexpr Mat3<T>
+toMat3(const Quat<T> &q) {
+    auto [w, x, y, z] = q;
+    return {{{
+        {1 - 2 * (y * y + z * z), 2 * (x * y + w * z), 2 * (x * z - w * y)},
+        {2 * (x * y - w * z), 1 - 2 * (x * x + z * z), 2 * (y * z + w * x)},
+        {2 * (x * z + w * y), 2 * (y * z - w * x), 1 - 2 * (x * x + y * y)},
+    }}};
+}
+
+/***
+ * Convert a rotation matrix to its equivalent quaternion.
+ * @param mat a 3x3 rotation matrix
+ * @return the unit quaternion representing the same rotation as the input matrix. Matrices that
+ *         are only nearly orthonormal, such as those left over from decomposing a scale, still
+ *         give a unit quaternion.
+ */
+template<typename T>
+constexpr Quat<T>
+toQuat(const Mat3<T> &mat) {
+    // https://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/
+    const auto &m     = mat.m;
+    auto        trace = m[0][0] + m[1][1] + m[2][2];
+    Quat<T>     q;
+    if (trace > 0) {
+        auto s = T(0.5) / sqrt(trace + T(1));
+        q      = {
+            T(0.25) / s,
+            (m[1][2] - m[2][1]) * s,
+            (m[2][0] - m[0][2]) * s,
+            (m[0][1] - m[1][0]) * s};
+    } else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+        auto s = T(2) * sqrt(T(1) + m[0][0] - m[1][1] - m[2][2]);
+        q      = {
+            (m[1][2] - m[2][1]) / s,
+            T(0.25) * s,
+            (m[1][0] + m[0][1]) / s,
+            (m[2][0] + m[0][2]) / s};
+    } else if (m[1][1] > m[2][2]) {
+        auto s = T(2) * sqrt(T(1) + m[1][1] - m[0][0] - m[2][2]);
+        q      = {
+            (m[2][0] - m[0][2]) / s,
+            (m[1][0] + m[0][1]) / s,
+            T(0.25) * s,
+            (m[2][1] + m[1][2]) / s};
+    } else {
+        auto s = T(2) * sqrt(T(1) + m[2][2] - m[0][0] - m[1][1]);
+        q      = {
+            (m[0][1] - m[1][0]) / s,
+            (m[2][0] + m[0][2]) / s,
+            (m[2][1] + m[1][2]) / s,
+            T(0.25) * s};
+    }
+    return normalize(q);
+}
+
+template<typename T>
+constexpr Mat3<T>
+operator*(const Mat3<T> &a, const Mat3<T> &b) {
+    Mat3<T> out;
+    for (int c = 0; c < 3; c++) {
+        for (int r = 0; r < 3; r++) {
+            out.m[c][r] = a.m[0][r] * b.m[c][0] + a.m[1][r] * b.m[c][1] + a.m[2][r] * b.m[c][2];
+        }
+    }
+    return out;
+}
+
+template<typename T>
+constexpr Mat4<T>
+operator*(const Mat4<T> &a, const Mat4<T> &b) {
+    Mat4<T> out;
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            out.m[c][r] = a.m[0][r] * b.m[c][0] + a.m[1][r] * b.m[c][1] +
+                          a.m[2][r] * b.m[c][2] + a.m[3][r] * b.m[c][3];
+        }
+    }
+    return out;
+}
+
+// Place a 3x3 block and a translation into an affine 4x4 matrix.
+template<typename T>
+constexpr Mat4<T>
+affine(const Mat3<T> &block, const Vec3<T> &translation) {
+    const auto &a = block.m;
+    return {{{
+        {a[0][0], a[0][1], a[0][2], 0},
+        {a[1][0], a[1][1], a[1][2], 0},
+        {a[2][0], a[2][1], a[2][2], 0},
+        {translation.x, translation.y, translation.z, 1},
+    }}};
+}
+
+/***
+ * Reconstruct an affine matrix from its translation, rotation, scale, and skew, the same way as
+ * BasicTransform::recompose().
+ * @param props the translation, rotation, scale, and skew to be joined into a matrix
+ * @return translation * rotation * scale * skew
+ */
+template<typename T>
+constexpr Mat4<T>
+recompose(const Properties<T> &props) {
+    auto [sx, sy, sz] = props.scale;
+    auto [kx, ky, kz] = props.skew;
+    // scale * skew, where skew is unit upper-triangular.
+    Mat3<T> scaleSkew{{{
+        {sx, 0, 0},
+        {sx * kx, sy, 0},
+        {sx * ky, sy * kz, sz},
+    }}};
+    return affine(toMat3(props.rotation) * scaleSkew, props.translation);
+}
+
+/***
+ * Reconstruct the inverse of an affine matrix from its translation, rotation, scale, and skew, the
+ * same way as BasicTransform::recomposeInverse().
+ * @param props the translation, rotation, scale, and skew of the matrix to be inverted
+ * @return the inverse of recompose(props)
+ */
+template<typename T>
+constexpr Mat4<T>
+recomposeInverse(const Properties<T> &props) {
+    auto [sx, sy, sz] = props.scale;
+    auto [kx, ky, kz] = props.skew;
+    // inverse(skew) * inverse(scale), where skew is unit upper-triangular.
+    Mat3<T> skewScale{{{
+        {1 / sx, 0, 0},
+        {-kx / sy, 1 / sy, 0},
+        {(kx * kz - ky) / sz, -kz / sz, 1 / sz},
+    }}};
+    auto  block = skewScale * toMat3(conjugate(props.rotation));
+    auto &b     = block.m;
+    auto  t     = props.translation;
+    return affine(
+        block,
+        Vec3<T>{
+            -(b[0][0] * t.x + b[1][0] * t.y + b[2][0] * t.z),
+            -(b[0][1] * t.x + b[1][1] * t.y + b[2][1] * t.z),
+            -(b[0][2] * t.x + b[1][2] * t.y + b[2][2] * t.z)});
+}
+
+/***
+ * Invert an affine matrix in closed form, the same way as BasicTransform::affineInverse().
+ * @param mat a 4x4 affine matrix, whose bottom row is (0, 0, 0, 1)
+ * @return the inverse of mat
+ */
+template<typename T>
+constexpr Mat4<T>
+affineInverse(const Mat4<T> &mat) {
+    const auto &m = mat.m;
+    // The rows of the inverse are the cross products of the other two columns, over the
+    // determinant.
+    auto cross = [&](int a, int b) {
+        return std::array<T, 3>{
+            m[a][1] * m[b][2] - m[a][2] * m[b][1],
+            m[a][2] * m[b][0] - m[a][0] * m[b][2],
+            m[a][0] * m[b][1] - m[a][1] * m[b][0]};
+    };
+    std::array<std::array<T, 3>, 3> rows{cross(1, 2), cross(2, 0), cross(0, 1)};
+    auto invDet = 1 / (m[0][0] * rows[0][0] + m[0][1] * rows[0][1] + m[0][2] * rows[0][2]);
+    std::array<T, 3> moved{};
+    Mat3<T>          block;
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+            block.m[c][r] = rows[r][c] * invDet;
+            moved[r] -= block.m[c][r] * m[3][c];
+        }
+    }
+    return affine(block, Vec3<T>{moved[0], moved[1], moved[2]});
+}
+
+/***
+ * Compute the world matrix of every Node in a prefab. Every Node's parent must come before it,
+ * as it would in a depth-first listing of the hierarchy.
+ * @param nodes the prefab's Nodes, parents first
+ * @return the local-to-world matrix of each Node, in the same order
+ * @throws std::invalid_argument if a Node's parent does not come before it. In a constant
+ *         expression this is a compile error instead.
+ */
+template<typename T, std::size_t N>
+constexpr std::array<Mat4<T>, N>
+flatten(const std::array<Node<T>, N> &nodes) {
+    std::array<Mat4<T>, N> worlds{};
+    for (std::size_t i = 0; i < N; i++) {
+        auto local = recompose(nodes[i].locals);
+        if (nodes[i].parent == none) {
+            worlds[i] = local;
+        } else if (nodes[i].parent < i) {
+            worlds[i] = worlds[nodes[i].parent] * local;
+        } else {
+            throw std::invalid_argument("prefab node's parent does not precede it");
+        }
+    }
+    return worlds;
+}
+
+// Conversions to and from the glm types used by BasicTransform<T>.
+
+template<typename T>
+typename BasicTransform<T>::Vec3
+toGlm(const Vec3<T> &v) {
+    return {v.x, v.y, v.z};
+}
+
+template<typename T>
+typename BasicTransform<T>::Quat
+toGlm(const Quat<T> &q) {
+    return {q.w, q.x, q.y, q.z};
+}
+
+template<typename T>
+typename BasicTransform<T>::Mat3
+toGlm(const Mat3<T> &mat) {
+    typename BasicTransform<T>::Mat3 out;
+    for (int c = 0; c < 3; c++) {
+        for (int r = 0; r < 3; r++) {
+            out[c][r] = mat.m[c][r];
+        }
+    }
+    return out;
+}
+
+template<typename T>
+typename BasicTransform<T>::Mat4
+toGlm(const Mat4<T> &mat) {
+    typename BasicTransform<T>::Mat4 out;
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            out[c][r] = mat.m[c][r];
+        }
+    }
+    return out;
+}
+
+template<typename T>
+typename BasicTransform<T>::Properties
+toGlm(const Properties<T> &props) {
+    return {toGlm(props.translation), toGlm(props.rotation), toGlm(props.scale), toGlm(props.skew)};
+}
+
+template<typename T>
+Vec3<T>
+fromGlm(const glm::vec<3, T, glm::defaultp> &v) {
+    return {v.x, v.y, v.z};
+}
+
+template<typename T>
+Quat<T>
+fromGlm(const glm::qua<T, glm::defaultp> &q) {
+    return {q.w, q.x, q.y, q.z};
+}
+
+template<typename T>
+Mat3<T>
+fromGlm(const glm::mat<3, 3, T, glm::defaultp> &mat) {
+    Mat3<T> out;
+    for (int c = 0; c < 3; c++) {
+        for (int r = 0; r < 3; r++) {
+            out.m[c][r] = mat[c][r];
+        }
+    }
+    return out;
+}
+
+template<typename T>
+Mat4<T>
+fromGlm(const glm::mat<4, 4, T, glm::defaultp> &mat) {
+    Mat4<T> out;
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            out.m[c][r] = mat[c][r];
+        }
+    }
+    return out;
+}
+
+} // namespace Prefab
@@ -0,0 +1,100 @@
+//
+// Created by taylor-santos on 10/17/2026 at 03:05.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "transform.h"
+
+/***
+ * Hands world matrices from a simulation thread to a reader thread, such as a renderer, without
+ * locks. Reading a Transform fills its caches, so a reader can't safely touch Transforms that
+ * another thread is changing. Instead, the simulation publishes an immutable, contiguous copy of
+ * the world matrices at the end of each tick, and the reader acquires the most recent one.
+ * Snapshots are triple-buffered: the writer fills one buffer while the reader holds another, and
+ * the third holds the most recently published snapshot, so neither thread ever waits on the other.
+ * Any number of ticks may be published between acquires; the reader only sees the latest.
+ * publish() must only be called from one thread at a time, and acquire() from one thread at a
+ * time, which may be different from the publishing thread.
+ */
+template<typename T>
+class BasicTransformSnapshots {
+public:
+    using Transform = BasicTransform<T>;
+    using Mat4      = typename Transform::Mat4;
+
+    struct Snapshot {
+        // Counts publishes, starting at 1. A snapshot with sequence 0 has never been published.
+        std::uint64_t     sequence{0};
+        std::vector<Mat4> matrices;
+    };
+
+    BasicTransformSnapshots() = default;
+
+    // The reader and writer may hold references into the buffers, so they must not be copied or
+    // moved.
+    BasicTransformSnapshots(const BasicTransformSnapshots &) = delete;
+    BasicTransformSnapshots &
+    operator=(const BasicTransformSnapshots &) = delete;
+
+    /**
+     * Publish the world matrices of the given Transforms, in the same order, as the next snapshot.
+     * Only the writer's own buffer is written, so this never waits for the reader.
+     * @param transforms the Transforms whose world matrices to publish
+     */
+    void
+    publish(std::span<const Transform *const> transforms);
+
+    /**
+     * Publish the world matrices of a Transform and all of its descendants, with each parent before
+     * its children, as the next snapshot. The whole hierarchy is brought up to date at once with
+     * updateWorldMatrices() before its matrices are copied.
+     * @param root the root of the hierarchy to publish
+     */
+    void
+    publish(const Transform &root);
+
+    /**
+     * Get the most recently published snapshot. Never touches any Transform and never waits for
+     * the writer. If nothing has been published since the last call, the same snapshot is returned
+     * again.
+     * @return the snapshot, which remains valid and unchanged until the next call to acquire()
+     */
+    [[nodiscard]] const Snapshot &
+    acquire();
+
+private:
+    // Set in shared_ when the buffer it names holds a snapshot that the reader hasn't acquired.
+    static constexpr std::uint32_t FRESH = 4;
+    static constexpr std::uint32_t INDEX = 3;
+
+    Snapshot buffers_[3];
+    // The buffer that sits between the writer and the reader, and the FRESH flag.
+    std::atomic<std::uint32_t> shared_{1};
+    // Owned by the writer.
+    std::uint32_t back_{2};
+    std::uint64_t published_{0};
+    // Owned by the reader.
+    std::uint32_t front_{0};
+    // Scratch space for publishing a hierarchy, owned by the writer.
+    std::vector<const Transform *> nodes_;
+
+private:
+    // Stamp the writer's buffer with the next sequence number and swap it into the middle.
+    void
+    swapBack();
+};
+
+extern template class BasicTransformSnapshots<float>;
+extern template class BasicTransformSnapshots<double>;
+
+// Snapshots of double-precision Transforms.
+using TransformSnapshots = BasicTransformSnapshots<double>;
+
+// Snapshots of single-precision Transforms.
+using TransformSnapshotsF = BasicTransformSnapshots<float>;
@@ -6,6 +6,10 @@
 
 #include "transform.h"
 
+Camera::Camera() {
+    updateAxes();
+}
+
 std::pair<float, float>
 Camera::getSensitivity() const {
     return sens_;
@@ -28,7 +32,8 @@ Camera::getFOV() const {
 
 void
 Camera::setFOV(float fov) {
-    fov_ = glm::radians(fov);
+    fov_             = glm::radians(fov);
+    projectionDirty_ = true;
 }
 
 void
@@ -36,6 +41,7 @@ Camera::addRotation(float yaw, float pitch) {
     auto [xSens, ySens] = sens_;
     yaw_                = glm::radians(glm::mod(glm::degrees(yaw_) + yaw * xSens, 360.0f));
     pitch_ = glm::radians(glm::clamp(glm::degrees(pitch_) + pitch * ySens, -90.0f, 90.0f));
+    updateAxes();
 }
 
 std::pair<float, float>
@@ -47,6 +53,7 @@ void
 Camera::setRotation(float yaw, float pitch) {
     yaw_   = glm::radians(glm::mod(yaw, 360.0f));
     pitch_ = glm::radians(glm::clamp(pitch, -90.0f, 90.0f));
+    updateAxes();
 }
 
 float
@@ -56,7 +63,8 @@ Camera::getNear() const {
 
 void
 Camera::setNear(float near) {
-    near_ = near;
+    near_            = near;
+    projectionDirty_ = true;
 }
 
 float
@@ -66,46 +74,118 @@ Camera::getFar() const {
 
 void
 Camera::setFar(float far) {
-    far_ = far;
+    far_             = far;
+    projectionDirty_ = true;
+}
+
+float
+Camera::getAspect() const {
+    return aspect_;
+}
+
+void
+Camera::setAspect(float aspect) {
+    if (std::isnan(aspect)) {
+        aspect = 1;
+    }
+    if (aspect != aspect_) {
+        aspect_          = aspect;
+        projectionDirty_ = true;
+    }
+}
+
+const glm::dvec3 &
+Camera::getOrigin() const {
+    return origin_;
+}
+
+void
+Camera::setOrigin(const glm::dvec3 &origin) {
+    if (origin != origin_) {
+        origin_    = origin;
+        viewDirty_ = true;
+    }
 }
 
 glm::vec3
 Camera::forward() const {
-    float cosP = glm::cos(pitch_);
-    float x    = -glm::sin(yaw_) * cosP;
-    float y    = glm::sin(pitch_);
-    float z    = glm::cos(yaw_) * cosP;
-    auto  f    = glm::vec3(x, y, z);
-    return f;
+    return forward_;
 }
 
 glm::vec3
 Camera::right() const {
-    return glm::vec3{-glm::cos(yaw_), 0, -glm::sin(yaw_)};
+    return right_;
 }
 
 glm::vec3
 Camera::up() const {
-    return {
-        glm::sin(pitch_) * glm::sin(yaw_),
-        glm::cos(pitch_),
-        -glm::cos(yaw_) * glm::sin(pitch_)};
+    return up_;
 }
 
-glm::mat4
-Camera::viewMatrix() const {
-    glm::vec3 pos = transform.position();
-    return glm::lookAt(pos, pos + forward(), up());
+void
+Camera::updateAxes() {
+    float sinY = glm::sin(yaw_), cosY = glm::cos(yaw_);
+    float sinP = glm::sin(pitch_), cosP = glm::cos(pitch_);
+    forward_   = {-sinY * cosP, sinP, cosY * cosP};
+    right_     = {-cosY, 0, -sinY};
+    up_        = {sinP * sinY, cosP, -cosY * sinP};
+    viewDirty_ = true;
+}
+
+const Camera::Matrices &
+Camera::matrices() const {
+    auto generation = transform.worldGeneration();
+    if (generation != viewGeneration_) {
+        viewGeneration_ = generation;
+        viewDirty_      = true;
+    }
+    if (!viewDirty_ && !projectionDirty_) {
+        return matrices_;
+    }
+    if (viewDirty_) {
+        // Subtract the origin in double precision, before narrowing, so that the view stays
+        // precise near the origin however far it is from the world origin.
+        glm::vec3 pos         = transform.position() - origin_;
+        matrices_.view        = glm::lookAt(pos, pos + forward_, up_);
+        matrices_.inverseView = glm::inverse(matrices_.view);
+    }
+    if (projectionDirty_) {
+        matrices_.projection        = glm::perspective(fov_, aspect_, near_, far_);
+        matrices_.inverseProjection = glm::inverse(matrices_.projection);
+    }
+    matrices_.viewProjection        = matrices_.projection * matrices_.view;
+    matrices_.inverseViewProjection = matrices_.inverseView * matrices_.inverseProjection;
+    viewDirty_                      = false;
+    projectionDirty_                = false;
+    return matrices_;
+}
+
+Frustum
+Camera::frustum() const {
+    return Frustum(matrices().viewProjection);
 }
 
 glm::mat4
 Camera::getMatrix(float aspect) const {
+    return getMatrix(aspect, glm::dvec3(0));
+}
+
+glm::mat4
+Camera::getMatrix(float aspect, const glm::dvec3 &origin) const {
     if (std::isnan(aspect)) {
         aspect = 1;
     }
-    glm::mat4 model      = glm::mat4(1.0f);
-    glm::mat4 view       = viewMatrix();
-    glm::mat4 projection = glm::perspective(fov_, aspect, near_, far_);
-    glm::mat4 mvp        = projection * view * model;
-    return mvp;
+    const auto &cached = matrices();
+    if (aspect == aspect_ && origin == origin_) {
+        return cached.viewProjection;
+    }
+    // Rebuild only what differs from the cached matrices, leaving them untouched.
+    glm::mat4 projection = aspect == aspect_ ? cached.projection
+                                             : glm::perspective(fov_, aspect, near_, far_);
+    glm::mat4 view       = cached.view;
+    if (origin != origin_) {
+        glm::vec3 pos = transform.position() - origin;
+        view          = glm::lookAt(pos, pos + forward_, up_);
+    }
+    return projection * view;
 }
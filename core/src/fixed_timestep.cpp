@@ -0,0 +1,50 @@
+//
+// Created by taylor-santos on 10/17/2026 at 10:05.
+//
+
+#include "fixed_timestep.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+FixedTimestep::FixedTimestep(double step, std::uint32_t maxSteps)
+    : step_{step}
+    , maxSteps_{maxSteps} {
+    if (!(step > 0)) {
+        throw std::invalid_argument("fixed timestep must be positive");
+    }
+    if (maxSteps == 0) {
+        throw std::invalid_argument("fixed timestep must allow at least one step per frame");
+    }
+}
+
+std::uint32_t
+FixedTimestep::advance(double elapsed) {
+    accumulator_ += std::max(elapsed, 0.0);
+    auto due = static_cast<std::uint64_t>(accumulator_ / step_);
+    // Time owed beyond maxSteps is dropped along with the steps it would have run.
+    accumulator_ = std::max(accumulator_ - static_cast<double>(due) * step_, 0.0);
+    auto run     = static_cast<std::uint32_t>(std::min<std::uint64_t>(due, maxSteps_));
+    steps_ += run;
+    return run;
+}
+
+double
+FixedTimestep::step() const {
+    return step_;
+}
+
+double
+FixedTimestep::alpha() const {
+    return std::min(accumulator_ / step_, 1.0);
+}
+
+double
+FixedTimestep::time() const {
+    return static_cast<double>(steps_) * step_;
+}
+
+std::uint64_t
+FixedTimestep::steps() const {
+    return steps_;
+}
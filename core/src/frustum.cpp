@@ -0,0 +1,159 @@
+//
+// Created by taylor-santos on 10/17/2026 at 11:30.
+//
+
+#include "frustum.h"
+#include "simd.h"
+
+#include <bit>
+#include <stdexcept>
+
+Frustum::Frustum(const glm::mat4 &viewProjection) {
+    // Each plane is the sum or difference of the matrix's last row and one of the others, as in
+    // Gribb and Hartmann's "Fast Extraction of Viewing Frustum Planes from the World-View-
+    // Projection Matrix".
+    auto row = [&](int i) {
+        return glm::vec4{
+            viewProjection[0][i],
+            viewProjection[1][i],
+            viewProjection[2][i],
+            viewProjection[3][i]};
+    };
+    planes_ = {
+        row(3) + row(0), // LEFT
+        row(3) - row(0), // RIGHT
+        row(3) + row(1), // BOTTOM
+        row(3) - row(1), // TOP
+        row(3) + row(2), // NEAR_CLIP
+        row(3) - row(2), // FAR_CLIP
+    };
+    for (auto &plane : planes_) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+}
+
+const glm::vec4 &
+Frustum::plane(Side side) const {
+    return planes_[static_cast<std::size_t>(side)];
+}
+
+bool
+Frustum::intersectsSphere(const glm::vec3 &center, float radius) const {
+    for (auto &plane : planes_) {
+        // Written so that boundary cases and NaNs agree with the batch test.
+        if (!(glm::dot(glm::vec3(plane), center) + plane.w > -radius)) return false;
+    }
+    return true;
+}
+
+bool
+Frustum::containsSphere(const glm::vec3 &center, float radius) const {
+    for (auto &plane : planes_) {
+        if (!(glm::dot(glm::vec3(plane), center) + plane.w >= radius)) return false;
+    }
+    return true;
+}
+
+bool
+Frustum::intersectsBox(const glm::vec3 &center, const glm::vec3 &extent) const {
+    for (auto &plane : planes_) {
+        // The box's projection onto the plane's normal reaches this far from its center.
+        auto reach = glm::dot(glm::abs(glm::vec3(plane)), extent);
+        if (!(glm::dot(glm::vec3(plane), center) + plane.w > -reach)) return false;
+    }
+    return true;
+}
+
+/***
+ * Run a visibility test over count bounds, Simd::Pack<float>::width at a time, and write the
+ * indices of the visible ones to visible. The final partial group is tested one bound at a time.
+ * @param count the number of bounds
+ * @param visible receives the visible indices, and must hold at least count
+ * @param group tests the group starting at an index, returning a bitmask of its visible lanes
+ * @param single tests the bound at an index
+ * @return the number of visible bounds
+ */
+template<typename Group, typename Single>
+static std::size_t
+compact(std::size_t count, std::span<std::uint32_t> visible, Group group, Single single) {
+    constexpr auto width = Simd::Pack<float>::width;
+    std::size_t    found = 0;
+    std::size_t    i     = 0;
+    for (; i + width <= count; i += width) {
+        for (unsigned mask = group(i); mask != 0; mask &= mask - 1) {
+            visible[found++] = static_cast<std::uint32_t>(i + std::countr_zero(mask));
+        }
+    }
+    for (; i < count; i++) {
+        if (single(i)) visible[found++] = static_cast<std::uint32_t>(i);
+    }
+    return found;
+}
+
+std::size_t
+Frustum::cull(const Spheres &spheres, std::span<std::uint32_t> visible) const {
+    auto count = spheres.x.size();
+    if (spheres.y.size() != count || spheres.z.size() != count || spheres.radius.size() != count) {
+        throw std::invalid_argument("sphere arrays must all be the same size");
+    }
+    if (visible.size() < count) {
+        throw std::invalid_argument("visible must hold an index for every sphere");
+    }
+    using P = Simd::Pack<float>;
+    return compact(
+        count,
+        visible,
+        [&](std::size_t i) {
+            P x = P::load(&spheres.x[i]), y = P::load(&spheres.y[i]), z = P::load(&spheres.z[i]);
+            P negRadius = -P::load(&spheres.radius[i]);
+            auto inside = [&](const glm::vec4 &plane) {
+                P distance = P(plane.x) * x + P(plane.y) * y + P(plane.z) * z + P(plane.w);
+                return distance > negRadius;
+            };
+            auto mask = inside(planes_[0]);
+            for (std::size_t p = 1; p < planes_.size(); p++) {
+                mask = mask & inside(planes_[p]);
+            }
+            return P::bits(mask);
+        },
+        [&](std::size_t i) {
+            return intersectsSphere({spheres.x[i], spheres.y[i], spheres.z[i]}, spheres.radius[i]);
+        });
+}
+
+std::size_t
+Frustum::cull(const Boxes &boxes, std::span<std::uint32_t> visible) const {
+    auto count = boxes.x.size();
+    if (boxes.y.size() != count || boxes.z.size() != count || boxes.extentX.size() != count ||
+        boxes.extentY.size() != count || boxes.extentZ.size() != count) {
+        throw std::invalid_argument("box arrays must all be the same size");
+    }
+    if (visible.size() < count) {
+        throw std::invalid_argument("visible must hold an index for every box");
+    }
+    using P = Simd::Pack<float>;
+    return compact(
+        count,
+        visible,
+        [&](std::size_t i) {
+            P x = P::load(&boxes.x[i]), y = P::load(&boxes.y[i]), z = P::load(&boxes.z[i]);
+            P ex = P::load(&boxes.extentX[i]), ey = P::load(&boxes.extentY[i]),
+              ez    = P::load(&boxes.extentZ[i]);
+            auto inside = [&](const glm::vec4 &plane) {
+                auto normal   = glm::abs(glm::vec3(plane));
+                P    distance = P(plane.x) * x + P(plane.y) * y + P(plane.z) * z + P(plane.w);
+                P    reach    = P(normal.x) * ex + P(normal.y) * ey + P(normal.z) * ez;
+                return distance > -reach;
+            };
+            auto mask = inside(planes_[0]);
+            for (std::size_t p = 1; p < planes_.size(); p++) {
+                mask = mask & inside(planes_[p]);
+            }
+            return P::bits(mask);
+        },
+        [&](std::size_t i) {
+            return intersectsBox(
+                {boxes.x[i], boxes.y[i], boxes.z[i]},
+                {boxes.extentX[i], boxes.extentY[i], boxes.extentZ[i]});
+        });
+}
@@ -0,0 +1,283 @@
+//
+// Created by taylor-santos on 10/17/2026 at 14:10.
+//
+
+#include "occlusion_buffer.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+// The depth of the far plane, which every pixel is reset to.
+static constexpr float FAR_DEPTH = 1.0f;
+
+OcclusionBuffer::OcclusionBuffer(std::uint32_t width, std::uint32_t height) {
+    if (width == 0 || height == 0) {
+        throw std::invalid_argument("occlusion buffer dimensions must be nonzero");
+    }
+    constexpr auto lanes  = static_cast<std::uint32_t>(Simd::Pack<float>::width);
+    std::uint32_t  stride = (width + lanes - 1) / lanes * lanes;
+    levels_.push_back(
+        {width, height, stride, std::vector<float>(std::size_t{stride} * height, FAR_DEPTH)});
+    // Each level halves the one before, rounding up, until a single texel covers the buffer.
+    while (width > 1 || height > 1) {
+        width  = (width + 1) / 2;
+        height = (height + 1) / 2;
+        levels_.push_back(
+            {width, height, width, std::vector<float>(std::size_t{width} * height, FAR_DEPTH)});
+    }
+}
+
+std::uint32_t
+OcclusionBuffer::width() const {
+    return levels_[0].width;
+}
+
+std::uint32_t
+OcclusionBuffer::height() const {
+    return levels_[0].height;
+}
+
+void
+OcclusionBuffer::clear(const glm::mat4 &viewProjection) {
+    viewProjection_ = viewProjection;
+    std::fill(levels_[0].depth.begin(), levels_[0].depth.end(), FAR_DEPTH);
+    hierarchyBuilt_ = false;
+}
+
+void
+OcclusionBuffer::rasterize(
+    std::span<const glm::vec3>     vertices,
+    std::span<const std::uint32_t> indices,
+    const glm::mat4               &model) {
+    if (indices.size() % 3 != 0) {
+        throw std::invalid_argument("occluder indices must form whole triangles");
+    }
+    for (auto index : indices) {
+        if (index >= vertices.size()) {
+            throw std::invalid_argument("occluder index is out of range");
+        }
+    }
+    hierarchyBuilt_ = false;
+    auto matrix     = viewProjection_ * model;
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        std::array<glm::vec4, 3> triangle;
+        for (std::size_t j = 0; j < 3; j++) {
+            triangle[j] = matrix * glm::vec4(vertices[indices[i + j]], 1);
+        }
+        // Clip against the near plane, keeping the side where z + w >= 0. Cutting one plane
+        // through a triangle leaves at most a quadrilateral.
+        std::array<glm::vec4, 4> polygon;
+        std::size_t              count = 0;
+        for (std::size_t j = 0; j < 3; j++) {
+            auto &curr    = triangle[j];
+            auto &next    = triangle[(j + 1) % 3];
+            float currIn  = curr.z + curr.w;
+            float nextIn  = next.z + next.w;
+            bool  keepCur = currIn >= 0;
+            if (keepCur) polygon[count++] = curr;
+            if (keepCur != (nextIn >= 0)) {
+                polygon[count++] = curr + (next - curr) * (currIn / (currIn - nextIn));
+            }
+        }
+        for (std::size_t j = 1; j + 1 < count; j++) {
+            fillTriangle(polygon[0], polygon[j], polygon[j + 1]);
+        }
+    }
+}
+
+void
+OcclusionBuffer::fillTriangle(const glm::vec4 &a, const glm::vec4 &b, const glm::vec4 &c) {
+    auto &level = levels_[0];
+    // Project into pixel coordinates, with depth from 0 at the near plane to 1 at the far plane.
+    auto toScreen = [&](const glm::vec4 &clip) {
+        auto ndc = glm::vec3(clip) / clip.w;
+        return glm::vec3{
+            (ndc.x + 1) * 0.5f * static_cast<float>(level.width),
+            (ndc.y + 1) * 0.5f * static_cast<float>(level.height),
+            (ndc.z + 1) * 0.5f};
+    };
+    std::array<glm::vec3, 3> v{toScreen(a), toScreen(b), toScreen(c)};
+    float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+    // Both sides occlude, so wind every triangle the same way.
+    if (area < 0) {
+        std::swap(v[1], v[2]);
+        area = -area;
+    }
+    // Skips degenerate triangles, and NaNs.
+    if (!(area > 0)) return;
+
+    // Only pixels whose centers lie within the triangle's bounds can be covered.
+    float left   = std::max(std::ceil(std::min({v[0].x, v[1].x, v[2].x}) - 0.5f), 0.0f);
+    float right  = std::min(
+        std::floor(std::max({v[0].x, v[1].x, v[2].x}) - 0.5f),
+        static_cast<float>(level.width - 1));
+    float bottom = std::max(std::ceil(std::min({v[0].y, v[1].y, v[2].y}) - 0.5f), 0.0f);
+    float top    = std::min(
+        std::floor(std::max({v[0].y, v[1].y, v[2].y}) - 0.5f),
+        static_cast<float>(level.height - 1));
+    if (!(left <= right && bottom <= top)) return;
+
+    // Each edge function, dx * x + dy * y + c, is positive inside the triangle, and proportional
+    // to the barycentric weight of the vertex opposite the edge.
+    struct Edge {
+        float dx, dy, c;
+    };
+    auto edge = [](const glm::vec3 &from, const glm::vec3 &to) {
+        float dx = from.y - to.y;
+        float dy = to.x - from.x;
+        return Edge{dx, dy, -(dx * from.x + dy * from.y)};
+    };
+    std::array<Edge, 3> edges{edge(v[1], v[2]), edge(v[2], v[0]), edge(v[0], v[1])};
+    // Projected depth is affine in screen space, so it is interpolated by the same weights.
+    Edge depth{0, 0, 0};
+    for (std::size_t i = 0; i < 3; i++) {
+        depth.dx += edges[i].dx * v[i].z / area;
+        depth.dy += edges[i].dy * v[i].z / area;
+        depth.c += edges[i].c * v[i].z / area;
+    }
+
+    using P = Simd::Pack<float>;
+    // Start each row on a whole pack, so that every load and store is of a full one.
+    auto firstX = static_cast<std::uint32_t>(left) / P::width * P::width;
+    auto lastX  = static_cast<std::uint32_t>(right);
+    std::array<float, P::width> offsets;
+    for (std::size_t i = 0; i < P::width; i++) {
+        offsets[i] = static_cast<float>(i) + 0.5f;
+    }
+    auto laneCenters = P::load(offsets.data());
+    for (auto y = static_cast<std::uint32_t>(bottom); y <= static_cast<std::uint32_t>(top); y++) {
+        float py  = static_cast<float>(y) + 0.5f;
+        auto *row = &level.depth[std::size_t{y} * level.stride];
+        // Lanes past the last pixel stay within the row's padding.
+        for (auto x = firstX; x <= lastX; x += P::width) {
+            P    px     = laneCenters + P(static_cast<float>(x));
+            auto inside = [&](const Edge &e) {
+                return P(e.dx) * px + P(e.dy * py + e.c) > P(0.0f);
+            };
+            P       z       = P(depth.dx) * px + P(depth.dy * py + depth.c);
+            P       old     = P::load(row + x);
+            P::Mask covered = inside(edges[0]) & inside(edges[1]) & inside(edges[2]) & (z < old);
+            select(covered, z, old).store(row + x);
+        }
+    }
+}
+
+void
+OcclusionBuffer::buildHierarchy() {
+    for (std::size_t l = 1; l < levels_.size(); l++) {
+        auto &fine   = levels_[l - 1];
+        auto &coarse = levels_[l];
+        auto  at     = [&](std::uint32_t x, std::uint32_t y) {
+            // An odd-sized level's last column and row stand in for the missing ones past them.
+            x = std::min(x, fine.width - 1);
+            y = std::min(y, fine.height - 1);
+            return fine.depth[std::size_t{y} * fine.stride + x];
+        };
+        for (std::uint32_t y = 0; y < coarse.height; y++) {
+            for (std::uint32_t x = 0; x < coarse.width; x++) {
+                coarse.depth[std::size_t{y} * coarse.stride + x] = std::max(
+                    {at(2 * x, 2 * y), at(2 * x + 1, 2 * y), at(2 * x, 2 * y + 1),
+                     at(2 * x + 1, 2 * y + 1)});
+            }
+        }
+    }
+    hierarchyBuilt_ = true;
+}
+
+bool
+OcclusionBuffer::occludesBox(const glm::vec3 &center, const glm::vec3 &extent) const {
+    if (!hierarchyBuilt_) {
+        throw std::logic_error("OcclusionBuffer::buildHierarchy() must be called before testing");
+    }
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    glm::vec2       low{inf}, high{-inf};
+    float           nearest = inf;
+    for (int corner = 0; corner < 8; corner++) {
+        auto offset = glm::vec3{
+            corner & 1 ? extent.x : -extent.x,
+            corner & 2 ? extent.y : -extent.y,
+            corner & 4 ? extent.z : -extent.z};
+        auto clip = viewProjection_ * glm::vec4(center + offset, 1);
+        // A corner in front of the near plane can't be projected, and the box may even surround
+        // the camera. Also catches NaNs.
+        if (!(clip.z + clip.w > 0)) return false;
+        auto ndc = glm::vec3(clip) / clip.w;
+        low      = glm::min(low, glm::vec2(ndc));
+        high     = glm::max(high, glm::vec2(ndc));
+        nearest  = std::min(nearest, ndc.z);
+    }
+    // Entirely beyond the far plane, where the Frustum culls it.
+    if (nearest > 1) return false;
+
+    // Find every pixel that the box's screen rectangle overlaps.
+    auto &base   = levels_[0];
+    auto  size   = glm::vec2(static_cast<float>(base.width), static_cast<float>(base.height));
+    auto  first  = (low + 1.0f) * 0.5f * size;
+    auto  last   = (high + 1.0f) * 0.5f * size;
+    if (last.x < 0 || last.y < 0 || first.x >= size.x || first.y >= size.y) return false;
+    auto x0 = static_cast<std::uint32_t>(std::max(std::floor(first.x), 0.0f));
+    auto y0 = static_cast<std::uint32_t>(std::max(std::floor(first.y), 0.0f));
+    auto x1 = static_cast<std::uint32_t>(std::min(std::floor(last.x), size.x - 1));
+    auto y1 = static_cast<std::uint32_t>(std::min(std::floor(last.y), size.y - 1));
+
+    // Read from the finest level where the rectangle spans at most two texels along each axis,
+    // or three if it straddles a texel boundary.
+    auto        span     = std::max(x1 - x0, y1 - y0) + 1;
+    auto        bits     = static_cast<std::size_t>(std::bit_width(span - 1));
+    std::size_t l        = std::min(bits > 0 ? bits - 1 : 0, levels_.size() - 1);
+    auto       &level    = levels_[l];
+    float       farthest = 0;
+    for (auto y = y0 >> l; y <= y1 >> l; y++) {
+        for (auto x = x0 >> l; x <= x1 >> l; x++) {
+            farthest = std::max(farthest, level.depth[std::size_t{y} * level.stride + x]);
+        }
+    }
+    // Nothing can be hidden where no occluder was drawn.
+    return farthest < FAR_DEPTH && (nearest + 1) * 0.5f > farthest;
+}
+
+bool
+OcclusionBuffer::occludesSphere(const glm::vec3 &center, float radius) const {
+    return occludesBox(center, glm::vec3(radius));
+}
+
+std::size_t
+OcclusionBuffer::cull(const Frustum::Boxes &boxes, std::span<std::uint32_t> visible) const {
+    auto count = boxes.x.size();
+    if (boxes.y.size() != count || boxes.z.size() != count || boxes.extentX.size() != count ||
+        boxes.extentY.size() != count || boxes.extentZ.size() != count) {
+        throw std::invalid_argument("box arrays must all be the same size");
+    }
+    for (auto index : visible) {
+        if (index >= count) {
+            throw std::invalid_argument("box index is out of range");
+        }
+    }
+    if (!hierarchyBuilt_) {
+        throw std::logic_error("OcclusionBuffer::buildHierarchy() must be called before testing");
+    }
+    std::size_t kept = 0;
+    for (auto index : visible) {
+        if (!occludesBox(
+                {boxes.x[index], boxes.y[index], boxes.z[index]},
+                {boxes.extentX[index], boxes.extentY[index], boxes.extentZ[index]})) {
+            visible[kept++] = index;
+        }
+    }
+    return kept;
+}
+
+float
+OcclusionBuffer::depth(std::uint32_t x, std::uint32_t y) const {
+    auto &base = levels_[0];
+    if (x >= base.width || y >= base.height) {
+        throw std::out_of_range("pixel is outside the occlusion buffer");
+    }
+    return base.depth[std::size_t{y} * base.stride + x];
+}
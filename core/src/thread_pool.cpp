@@ -0,0 +1,146 @@
+//
+// Created by taylor-santos on 10/16/2026 at 22:14.
+//
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+// The pool and queue owned by the current thread, if it is a worker.
+static thread_local const ThreadPool *currentPool  = nullptr;
+static thread_local std::size_t       currentQueue = 0;
+
+ThreadPool::TaskGroup::TaskGroup(ThreadPool &pool)
+    : pool_{pool} {}
+
+ThreadPool::TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+        // Destructors must not throw. Call wait() explicitly to observe task exceptions.
+    }
+}
+
+void
+ThreadPool::TaskGroup::run(std::function<void()> task) {
+    pending_++;
+    pool_.submit([this, task = std::move(task)] {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard lock(errorMutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+        pending_--;
+    });
+}
+
+void
+ThreadPool::TaskGroup::wait() {
+    while (pending_ > 0) {
+        // Help out rather than block. This may run tasks from other groups, which is harmless.
+        if (!pool_.runPendingTask()) std::this_thread::yield();
+    }
+    std::lock_guard lock(errorMutex_);
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    // Even without workers there must be somewhere to put submitted tasks.
+    auto queueCount = std::max<std::size_t>(threadCount, 1);
+    for (std::size_t i = 0; i < queueCount; i++) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 0; i < threadCount; i++) {
+        workers_.emplace_back([this, i] { work(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(sleepMutex_);
+        stopping_ = true;
+    }
+    sleepCondition_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+    // Without workers, nothing else will run the remaining tasks.
+    while (runPendingTask()) {}
+}
+
+std::size_t
+ThreadPool::size() const {
+    return workers_.size();
+}
+
+void
+ThreadPool::submit(std::function<void()> task) {
+    auto index = currentPool == this ? currentQueue : nextQueue_++ % queues_.size();
+    {
+        // Count the task before it becomes visible so that the count can never underflow, and do
+        // so under the sleep mutex so that a worker can't miss the notification between checking
+        // the count and going to sleep.
+        std::lock_guard lock(sleepMutex_);
+        queued_++;
+    }
+    {
+        std::lock_guard lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    sleepCondition_.notify_one();
+}
+
+bool
+ThreadPool::runPendingTask() {
+    auto index = currentPool == this ? currentQueue : nextQueue_++ % queues_.size();
+    if (auto task = take(index)) {
+        task();
+        return true;
+    }
+    return false;
+}
+
+std::function<void()>
+ThreadPool::take(std::size_t queueIndex) {
+    if (queued_ == 0) return {};
+    {
+        auto &own = *queues_[queueIndex];
+        std::lock_guard lock(own.mutex);
+        if (!own.tasks.empty()) {
+            auto task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued_--;
+            return task;
+        }
+    }
+    for (std::size_t i = 1; i < queues_.size(); i++) {
+        auto &other = *queues_[(queueIndex + i) % queues_.size()];
+        std::lock_guard lock(other.mutex);
+        if (!other.tasks.empty()) {
+            auto task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            queued_--;
+            return task;
+        }
+    }
+    return {};
+}
+
+void
+ThreadPool::work(std::size_t queueIndex) {
+    currentPool  = this;
+    currentQueue = queueIndex;
+    while (true) {
+        if (auto task = take(queueIndex)) {
+            task();
+            continue;
+        }
+        std::unique_lock lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+        if (stopping_ && queued_ == 0) return;
+    }
+}
@@ -3,54 +3,41 @@
 //
 
 #include "transform.h"
+#include "frustum.h"
+#include "simd.h"
+#include "thread_pool.h"
+#include "transform_bake.h"
+#include "transform_journal.h"
+#include "transform_prefab.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <initializer_list>
+#include <limits>
 #include <ostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "glm/gtc/random.hpp"
+#include "glm/gtc/type_ptr.hpp"
 #include "glm/ext/matrix_relational.hpp"
 
-#define EPSILON 0.00001
+#define EPSILON static_cast<T>(0.00001)
 
 /***
  * Convert a rotation matrix to its equivalent quaternion.
  * @param mat a 3x3 rotation matrix
  * @return the quaternion representing the same rotation as the input matrix
  */
-static glm::dquat
-matToQuat(glm::dmat3 mat) {
-    // https://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToQuaternion/
-    glm::dquat q;
-    auto       trace = mat[0][0] + mat[1][1] + mat[2][2];
-    if (trace > 0) {
-        auto s = 0.5 / glm::sqrt(trace + 1.0);
-        q.w    = 0.25 / s;
-        q.x    = (mat[1][2] - mat[2][1]) * s;
-        q.y    = (mat[2][0] - mat[0][2]) * s;
-        q.z    = (mat[0][1] - mat[1][0]) * s;
-    } else {
-        if (mat[0][0] > mat[1][1] && mat[0][0] > mat[2][2]) {
-            auto s = 2.0 * glm::sqrt(1.0 + mat[0][0] - mat[1][1] - mat[2][2]);
-            q.w    = (mat[1][2] - mat[2][1]) / s;
-            q.x    = 0.25 * s;
-            q.y    = (mat[1][0] + mat[0][1]) / s;
-            q.z    = (mat[2][0] + mat[0][2]) / s;
-        } else if (mat[1][1] > mat[2][2]) {
-            auto s = 2.0 * glm::sqrt(1.0 + mat[1][1] - mat[0][0] - mat[2][2]);
-            q.w    = (mat[2][0] - mat[0][2]) / s;
-            q.x    = (mat[1][0] + mat[0][1]) / s;
-            q.y    = 0.25 * s;
-            q.z    = (mat[2][1] + mat[1][2]) / s;
-        } else {
-            auto s = 2.0 * glm::sqrt(1.0 + mat[2][2] - mat[0][0] - mat[1][1]);
-            q.w    = (mat[0][1] - mat[1][0]) / s;
-            q.x    = (mat[2][0] + mat[0][2]) / s;
-            q.y    = (mat[2][1] + mat[1][2]) / s;
-            q.z    = 0.25 * s;
-        }
-    }
-    q = glm::normalize(q);
-    return q;
+template<typename T>
+static glm::qua<T, glm::defaultp>
+matToQuat(glm::mat<3, 3, T, glm::defaultp> mat) {
+    return Prefab::toGlm(Prefab::toQuat(Prefab::fromGlm(mat)));
 }
 
 /***
@@ -58,10 +45,11 @@ matToQuat(glm::dmat3 mat) {
  * @param A the 3x3 matrix to be decomposed
  * @return the Cholesky decomposition of the input matrix
  */
-static glm::dmat3
-cholesky(glm::dmat3 A) {
+template<typename T>
+static glm::mat<3, 3, T, glm::defaultp>
+cholesky(glm::mat<3, 3, T, glm::defaultp> A) {
     // https://rosettacode.org/wiki/Cholesky_decomposition#C.2B.2B
-    glm::dmat3 result{0};
+    glm::mat<3, 3, T, glm::defaultp> result{0};
     for (int i = 0; i < 3; ++i) {
         for (int k = 0; k < i; ++k) {
             auto value = A[i][k];
@@ -75,21 +63,21 @@ cholesky(glm::dmat3 A) {
     return result;
 }
 
-Transform::Properties
-Transform::decompose(glm::dmat4 mat) {
+template<typename T>
+typename BasicTransform<T>::Properties
+BasicTransform<T>::decompose(Mat4 mat) {
     // https://github.com/matthew-brett/transforms3d/blob/master/transforms3d/affines.py
-    glm::dvec3 translation;
-    glm::dquat rotation;
-    glm::dvec3 scale;
-    glm::dvec3 skew;
-    translation    = mat[3];
-    glm::dmat3 RZS = mat; // Strip off translation components
-    auto       ZS  = cholesky(glm::transpose(RZS) * RZS);
-    scale          = glm::dvec3{ZS[0][0], ZS[1][1], ZS[2][2]};
-    auto ZST       = glm::transpose(ZS);
-    auto shears =
-        glm::transpose(glm::dmat3{ZST[0] / scale[0], ZST[1] / scale[1], ZST[2] / scale[2]});
-    skew        = glm::dvec3{shears[1][0], shears[2][0], shears[2][1]};
+    Vec3 translation;
+    Quat rotation;
+    Vec3 scale;
+    Vec3 skew;
+    translation = mat[3];
+    Mat3 RZS    = mat; // Strip off translation components
+    auto ZS     = cholesky(glm::transpose(RZS) * RZS);
+    scale       = Vec3{ZS[0][0], ZS[1][1], ZS[2][2]};
+    auto ZST    = glm::transpose(ZS);
+    auto shears = glm::transpose(Mat3{ZST[0] / scale[0], ZST[1] / scale[1], ZST[2] / scale[2]});
+    skew        = Vec3{shears[1][0], shears[2][0], shears[2][1]};
     auto rotMat = RZS * glm::inverse(ZS);
     if (glm::determinant(rotMat) < 0) {
         scale[0] *= -1;
@@ -100,44 +88,342 @@ Transform::decompose(glm::dmat4 mat) {
     return {translation, rotation, scale, skew};
 }
 
-glm::dmat4
-Transform::recompose(const Transform::Properties &mat) {
-    auto       rotMat = glm::toMat3(mat.rotation);
-    glm::dmat3 skewMat{1};
-    skewMat[1][0] = mat.skew.x;
-    skewMat[2][0] = mat.skew.y;
-    skewMat[2][1] = mat.skew.z;
-    glm::dmat3 scaleMat{0};
-    scaleMat[0][0] = mat.scale[0];
-    scaleMat[1][1] = mat.scale[1];
-    scaleMat[2][2] = mat.scale[2];
-    auto A         = rotMat * scaleMat * skewMat;
-    return glm::dmat4{
-        glm::dvec4{A[0], 0},
-        glm::dvec4{A[1], 0},
-        glm::dvec4{A[2], 0},
-        glm::dvec4{mat.translation, 1}};
-}
-
-glm::dmat4
-Transform::recomposeInverse(const Transform::Properties &mat) {
-    auto       rotMat = glm::toMat4(glm::conjugate(mat.rotation));
-    glm::dmat4 skewMat{1};
-    skewMat[1][0] = -mat.skew.x;
-    skewMat[2][0] = mat.skew.x * mat.skew.z - mat.skew.y;
-    skewMat[2][1] = -mat.skew.z;
-    glm::dmat4 scaleMat{1};
-    scaleMat[0][0] = 1 / mat.scale[0];
-    scaleMat[1][1] = 1 / mat.scale[1];
-    scaleMat[2][2] = 1 / mat.scale[2];
-    glm::dmat4 trMat{1};
-    trMat[3] = glm::dvec4{-mat.translation, 1};
-    return skewMat * scaleMat * rotMat * trMat;
-}
-
-Transform::Transform() = default;
-
-Transform::Transform(Transform *parent, Properties properties)
+// The scalar recompose functions share their math with the constexpr versions in
+// transform_prefab.h, so that prefabs flattened at compile time match Transforms built at runtime.
+template<typename T>
+typename BasicTransform<T>::Mat4
+BasicTransform<T>::recompose(const Properties &mat) {
+    return Prefab::toGlm(Prefab::recompose(Prefab::Properties<T>{
+        Prefab::fromGlm(mat.translation),
+        Prefab::fromGlm(mat.rotation),
+        Prefab::fromGlm(mat.scale),
+        Prefab::fromGlm(mat.skew)}));
+}
+
+template<typename T>
+typename BasicTransform<T>::Mat4
+BasicTransform<T>::recomposeInverse(const Properties &mat) {
+    return Prefab::toGlm(Prefab::recomposeInverse(Prefab::Properties<T>{
+        Prefab::fromGlm(mat.translation),
+        Prefab::fromGlm(mat.rotation),
+        Prefab::fromGlm(mat.scale),
+        Prefab::fromGlm(mat.skew)}));
+}
+
+template<typename T>
+typename BasicTransform<T>::Mat4
+BasicTransform<T>::affineInverse(const Mat4 &mat) {
+    auto c0 = Vec3(mat[0]);
+    auto c1 = Vec3(mat[1]);
+    auto c2 = Vec3(mat[2]);
+    // The rows of the inverse are the cross products of the other two columns, over the
+    // determinant.
+    auto r0     = glm::cross(c1, c2);
+    auto r1     = glm::cross(c2, c0);
+    auto r2     = glm::cross(c0, c1);
+    auto invDet = 1 / glm::dot(c0, r0);
+    r0 *= invDet;
+    r1 *= invDet;
+    r2 *= invDet;
+    auto t = Vec3(mat[3]);
+    return Mat4{
+        Vec4{r0.x, r1.x, r2.x, 0},
+        Vec4{r0.y, r1.y, r2.y, 0},
+        Vec4{r0.z, r1.z, r2.z, 0},
+        Vec4{-glm::dot(r0, t), -glm::dot(r1, t), -glm::dot(r2, t), 1}};
+}
+
+/***
+ * Decompose one Simd::Pack<T>::width-sized group of matrices, one matrix per lane. This is the same
+ * algorithm as the scalar decompose(), but with the Cholesky factorization and the triangular
+ * inverse written out in closed form, and with every branch of matToQuat() replaced by a select()
+ * so that all lanes run the same instructions.
+ * @param mats the first of width consecutive matrices
+ * @param out the first of width consecutive outputs
+ */
+template<typename T>
+static void
+decomposeLanes(
+    const glm::mat<4, 4, T, glm::defaultp> *mats,
+    typename BasicTransform<T>::Properties *out) {
+    using P                  = Simd::Pack<T>;
+    constexpr auto inStride  = sizeof(*mats) / sizeof(T);
+    constexpr auto outStride = sizeof(*out) / sizeof(T);
+    static_assert(sizeof(*mats) % sizeof(T) == 0 && sizeof(*out) % sizeof(T) == 0);
+    auto m = [&](int c, int r) {
+        return P::gather(&mats[0][c][r], inStride);
+    };
+    P a00 = m(0, 0), a01 = m(0, 1), a02 = m(0, 2);
+    P a10 = m(1, 0), a11 = m(1, 1), a12 = m(1, 2);
+    P a20 = m(2, 0), a21 = m(2, 1), a22 = m(2, 2);
+
+    // Cholesky factorization of transpose(A) * A, giving the upper-triangular scale/skew matrix Z.
+    P g00 = a00 * a00 + a01 * a01 + a02 * a02;
+    P g10 = a10 * a00 + a11 * a01 + a12 * a02;
+    P g11 = a10 * a10 + a11 * a11 + a12 * a12;
+    P g20 = a20 * a00 + a21 * a01 + a22 * a02;
+    P g21 = a20 * a10 + a21 * a11 + a22 * a12;
+    P g22 = a20 * a20 + a21 * a21 + a22 * a22;
+    P z00 = sqrt(g00);
+    P z10 = g10 / z00;
+    P z11 = sqrt(g11 - z10 * z10);
+    P z20 = g20 / z00;
+    P z21 = (g21 - z20 * z10) / z11;
+    P z22 = sqrt(g22 - z20 * z20 - z21 * z21);
+    P kx  = z10 / z00;
+    P ky  = z20 / z00;
+    P kz  = z21 / z11;
+
+    // A reflection is folded into the x scale. Z's diagonal is positive, so A's determinant has the
+    // same sign as the rotation matrix's.
+    P det = a00 * (a11 * a22 - a12 * a21) - a10 * (a01 * a22 - a02 * a21) +
+            a20 * (a01 * a12 - a02 * a11);
+    P sx  = select(det < P(0), -z00, z00);
+
+    // R = A * inverse(Z), using the closed-form inverse of an upper-triangular matrix.
+    P i00 = P(1) / sx;
+    P i11 = P(1) / z11;
+    P i22 = P(1) / z22;
+    P i01 = -z10 * i00 * i11;
+    P i12 = -z21 * i11 * i22;
+    P i02 = (z10 * z21 - z11 * z20) * i00 * i11 * i22;
+    P m00 = a00 * i00, m01 = a01 * i00, m02 = a02 * i00;
+    P m10 = a00 * i01 + a10 * i11, m11 = a01 * i01 + a11 * i11, m12 = a02 * i01 + a12 * i11;
+    P m20 = a00 * i02 + a10 * i12 + a20 * i22;
+    P m21 = a01 * i02 + a11 * i12 + a21 * i22;
+    P m22 = a02 * i02 + a12 * i12 + a22 * i22;
+
+    // matToQuat(R). Each of its four cases takes the square root of a different diagonal
+    // combination, scales it into one component, and divides the others by it.
+    P    trace    = m00 + m11 + m22;
+    auto useTrace = trace > P(0);
+    auto useX     = (m00 > m11) & (m00 > m22);
+    auto useY     = m11 > m22;
+    P    diagY    = select(useY, m11 - m00 - m22, m22 - m00 - m11);
+    P    diagX    = select(useX, m00 - m11 - m22, diagY);
+    P    root     = sqrt(P(1) + select(useTrace, trace, diagX));
+    P    big      = P(T(0.5)) * root;
+    P    inv      = P(T(0.5)) / root;
+    P wx  = (m12 - m21) * inv, wy = (m20 - m02) * inv, wz = (m01 - m10) * inv;
+    P xy  = (m10 + m01) * inv, xz = (m20 + m02) * inv, yz = (m21 + m12) * inv;
+    P qw  = select(useTrace, big, select(useX, wx, select(useY, wy, wz)));
+    P qx  = select(useTrace, wx, select(useX, big, select(useY, xy, xz)));
+    P qy  = select(useTrace, wy, select(useX, xy, select(useY, big, yz)));
+    P qz  = select(useTrace, wz, select(useX, xz, select(useY, yz, big)));
+    P len = P(1) / sqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+
+    m(3, 0).scatter(&out->translation.x, outStride);
+    m(3, 1).scatter(&out->translation.y, outStride);
+    m(3, 2).scatter(&out->translation.z, outStride);
+    (qw * len).scatter(&out->rotation.w, outStride);
+    (qx * len).scatter(&out->rotation.x, outStride);
+    (qy * len).scatter(&out->rotation.y, outStride);
+    (qz * len).scatter(&out->rotation.z, outStride);
+    sx.scatter(&out->scale.x, outStride);
+    z11.scatter(&out->scale.y, outStride);
+    z22.scatter(&out->scale.z, outStride);
+    kx.scatter(&out->skew.x, outStride);
+    ky.scatter(&out->skew.y, outStride);
+    kz.scatter(&out->skew.z, outStride);
+}
+
+/***
+ * Recompose one Simd::Pack<T>::width-sized group of matrices, one matrix per lane. Computes
+ * rotation * scale * skew directly from the quaternion instead of building three 3x3 matrices.
+ * @param props the first of width consecutive inputs
+ * @param out the first of width consecutive output matrices
+ */
+template<typename T>
+static void
+recomposeLanes(
+    const typename BasicTransform<T>::Properties *props,
+    glm::mat<4, 4, T, glm::defaultp>             *out) {
+    using P                  = Simd::Pack<T>;
+    constexpr auto inStride  = sizeof(*props) / sizeof(T);
+    constexpr auto outStride = sizeof(*out) / sizeof(T);
+    static_assert(sizeof(*props) % sizeof(T) == 0 && sizeof(*out) % sizeof(T) == 0);
+    auto p = [&](const T &first) {
+        return P::gather(&first, inStride);
+    };
+    P qw = p(props->rotation.w), qx = p(props->rotation.x);
+    P qy = p(props->rotation.y), qz = p(props->rotation.z);
+    P sx = p(props->scale.x), sy = p(props->scale.y), sz = p(props->scale.z);
+    P kx = p(props->skew.x), ky = p(props->skew.y), kz = p(props->skew.z);
+
+    // glm::toMat3(rotation)
+    P r00 = P(1) - P(2) * (qy * qy + qz * qz);
+    P r01 = P(2) * (qx * qy + qw * qz);
+    P r02 = P(2) * (qx * qz - qw * qy);
+    P r10 = P(2) * (qx * qy - qw * qz);
+    P r11 = P(1) - P(2) * (qx * qx + qz * qz);
+    P r12 = P(2) * (qy * qz + qw * qx);
+    P r20 = P(2) * (qx * qz + qw * qy);
+    P r21 = P(2) * (qy * qz - qw * qx);
+    P r22 = P(1) - P(2) * (qx * qx + qy * qy);
+
+    // The columns of rotation * scale * skew, where skew is unit upper-triangular.
+    P c1x = sx * kx, c2x = sx * ky, c2y = sy * kz;
+    P a[3][3] = {
+        {r00 * sx, r01 * sx, r02 * sx},
+        {r00 * c1x + r10 * sy, r01 * c1x + r11 * sy, r02 * c1x + r12 * sy},
+        {r00 * c2x + r10 * c2y + r20 * sz,
+         r01 * c2x + r11 * c2y + r21 * sz,
+         r02 * c2x + r12 * c2y + r22 * sz}};
+    for (int c = 0; c < 3; c++) {
+        for (int r = 0; r < 3; r++) {
+            a[c][r].scatter(&out[0][c][r], outStride);
+        }
+        P(0).scatter(&out[0][c][3], outStride);
+    }
+    p(props->translation.x).scatter(&out[0][3][0], outStride);
+    p(props->translation.y).scatter(&out[0][3][1], outStride);
+    p(props->translation.z).scatter(&out[0][3][2], outStride);
+    P(1).scatter(&out[0][3][3], outStride);
+}
+
+/***
+ * Run a lane kernel over two equally sized spans, width elements at a time. The final partial
+ * group, if any, is padded with default-constructed inputs so the kernel never reads or writes
+ * past the end of either span.
+ */
+template<typename T, typename In, typename Out, typename Kernel>
+static void
+forEachLaneGroup(std::span<const In> in, std::span<Out> out, Kernel kernel) {
+    if (in.size() != out.size()) {
+        throw std::invalid_argument("Batch input and output spans must be the same size");
+    }
+    constexpr auto width = Simd::Pack<T>::width;
+    std::size_t    i     = 0;
+    for (; i + width <= in.size(); i += width) {
+        kernel(&in[i], &out[i]);
+    }
+    if (i < in.size()) {
+        std::array<In, width>  tailIn{};
+        std::array<Out, width> tailOut{};
+        std::copy(in.begin() + i, in.end(), tailIn.begin());
+        kernel(tailIn.data(), tailOut.data());
+        std::copy_n(tailOut.begin(), in.size() - i, out.begin() + i);
+    }
+}
+
+/***
+ * Multiply Simd::Pack<T>::width-sized groups of vectors by one affine matrix, one vector per lane.
+ * The matrix is broadcast into registers once, when the kernel is constructed. Vectors are treated
+ * as points if W is 1, or as directions, which ignore the translation, if W is 0.
+ */
+template<typename T, int W>
+class AffineLanes {
+public:
+    using P    = Simd::Pack<T>;
+    using Vec3 = glm::vec<3, T, glm::defaultp>;
+
+    explicit AffineLanes(const glm::mat<4, 4, T, glm::defaultp> &mat) {
+        for (int c = 0; c < 4; c++) {
+            for (int r = 0; r < 3; r++) {
+                m_[c][r] = P(mat[c][r]);
+            }
+        }
+    }
+
+    // Transform the width consecutive vectors at in into the width consecutive vectors at out.
+    // Every input is loaded before any output is stored, so in and out may be the same.
+    void
+    operator()(const Vec3 *in, Vec3 *out) const {
+        constexpr auto stride = sizeof(Vec3) / sizeof(T);
+        static_assert(sizeof(Vec3) % sizeof(T) == 0);
+        P x = P::gather(&in->x, stride);
+        P y = P::gather(&in->y, stride);
+        P z = P::gather(&in->z, stride);
+        P v[3];
+        for (int r = 0; r < 3; r++) {
+            v[r] = m_[0][r] * x + m_[1][r] * y + m_[2][r] * z;
+            if constexpr (W == 1) {
+                v[r] = v[r] + m_[3][r];
+            }
+        }
+        for (int r = 0; r < 3; r++) {
+            v[r].scatter(&out[0][r], stride);
+        }
+    }
+
+private:
+    P m_[4][3];
+};
+
+template<typename T>
+void
+BasicTransform<T>::decompose(std::span<const Mat4> mats, std::span<Properties> out) {
+    forEachLaneGroup<T>(mats, out, decomposeLanes<T>);
+}
+
+template<typename T>
+void
+BasicTransform<T>::recompose(std::span<const Properties> props, std::span<Mat4> out) {
+    forEachLaneGroup<T>(props, out, recomposeLanes<T>);
+}
+
+// Check that an export buffer is aligned and holds exactly 16 floats for each of count matrices.
+static void
+checkExportBuffer(std::size_t count, std::span<float> out) {
+    if (out.size() != 16 * count) {
+        throw std::invalid_argument("Export buffer must hold exactly 16 floats per matrix");
+    }
+    if (reinterpret_cast<std::uintptr_t>(out.data()) % 16 != 0) {
+        throw std::invalid_argument("Export buffer must be 16-byte aligned");
+    }
+}
+
+/***
+ * Narrow one matrix into 16 floats, subtracting origin from its translation before the translation
+ * loses any precision.
+ * @param mat the matrix to narrow
+ * @param origin the point to subtract from the translation
+ * @param dst receives the 16 floats, and must be 16-byte aligned
+ */
+template<typename T>
+static void
+narrowRelative(
+    const glm::mat<4, 4, T, glm::defaultp> &mat,
+    glm::vec<3, T, glm::defaultp>           origin,
+    float                                  *dst) {
+    // glm stores matrices as 16 tightly packed values, so the first three columns are narrowed at
+    // once.
+    static_assert(sizeof(mat) == 16 * sizeof(T));
+    Simd::narrow(glm::value_ptr(mat), dst, 12);
+    auto translation = glm::vec<3, T, glm::defaultp>(mat[3]) - origin;
+    dst[12]          = static_cast<float>(translation.x);
+    dst[13]          = static_cast<float>(translation.y);
+    dst[14]          = static_cast<float>(translation.z);
+    dst[15]          = static_cast<float>(mat[3][3]);
+}
+
+template<typename T>
+void
+BasicTransform<T>::exportMatrices(std::span<const Mat4> mats, std::span<float> out, Vec3 origin) {
+    checkExportBuffer(mats.size(), out);
+    for (std::size_t i = 0; i < mats.size(); i++) {
+        narrowRelative(mats[i], origin, &out[16 * i]);
+    }
+}
+
+template<typename T>
+void
+BasicTransform<T>::exportWorldMatrices(
+    std::span<const BasicTransform *const> transforms,
+    std::span<float>                       out,
+    Vec3                                   origin) {
+    checkExportBuffer(transforms.size(), out);
+    for (std::size_t i = 0; i < transforms.size(); i++) {
+        transforms[i]->validateCache();
+        narrowRelative(transforms[i]->cachedLocalToWorld(), origin, &out[16 * i]);
+    }
+}
+
+template<typename T>
+BasicTransform<T>::BasicTransform() = default;
+
+template<typename T>
+BasicTransform<T>::BasicTransform(BasicTransform *parent, Properties properties)
     : parent_{parent}
     , locals_{properties} {
     if (parent_) {
@@ -145,41 +431,66 @@ Transform::Transform(Transform *parent, Properties properties)
     }
 }
 
-Transform::Transform(const Transform &other)
-    : Transform(other.parent_, other.locals_) {}
+template<typename T>
+BasicTransform<T>::BasicTransform(const BasicTransform &other)
+    : BasicTransform(other.parent_, other.locals_) {
+    // The local bounds are set by the user, like the local properties, even though they live
+    // alongside the caches.
+    if (auto bounds = other.localBounds()) {
+        cache().localBounds = bounds;
+    }
+}
 
-Transform::Transform(Transform &&other) noexcept
-    : Transform() {
-    swap(*this, other);
+template<typename T>
+BasicTransform<T>::BasicTransform(BasicTransform &&other) noexcept
+    : BasicTransform() {
+    swap(other);
 }
 
-Transform &
-Transform::operator=(const Transform &other) {
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::operator=(const BasicTransform &other) {
     if (this == &other) return *this;
-    Transform temp(other);
-    swap(*this, temp);
+    checkNotFrozen();
+    BasicTransform temp(other);
+    swap(temp);
+    // Only the copied properties change hands; this Transform stays in its own journal.
+    swapJournals(temp);
+    markChanged();
     return *this;
 }
 
-Transform &
-Transform::operator=(Transform &&other) noexcept {
-    swap(*this, other);
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::operator=(BasicTransform &&other) noexcept {
+    swap(other);
     return *this;
 }
 
-Transform::~Transform() {
+template<typename T>
+BasicTransform<T>::~BasicTransform() {
+    if (journal_) {
+        journal_->untrack(*this);
+    }
+    if (frozen_) {
+        cache_->bake->forget(this);
+    }
     if (parent_) {
-        parent_->children_.erase(parentIt_);
+        parent_->removeChild(this);
     }
-    while (!children_.empty()) {
-        // Readjust children's local properties to keep them fixed in world space.
-        auto child = children_.front();
+    while (firstChild_) {
+        // Readjust children's local properties to keep them fixed in world space. That leaves a
+        // frozen child's world matrix as it was baked, so it is briefly thawed to allow it.
+        auto *child  = firstChild_;
+        bool  frozen = std::exchange(child->frozen_, false);
         child->setParent(nullptr);
+        child->frozen_ = frozen;
     }
 }
 
+template<typename T>
 bool
-Transform::operator==(const Transform &other) const {
+BasicTransform<T>::operator==(const BasicTransform &other) const {
     if (parent_ != other.parent_) return false;
     if (glm::any(glm::epsilonNotEqual(locals_.translation, other.locals_.translation, EPSILON)))
         return false;
@@ -193,51 +504,255 @@ Transform::operator==(const Transform &other) const {
     return true;
 }
 
+template<typename T>
 void
-swap(Transform &first, Transform &second) noexcept {
+BasicTransform<T>::swap(BasicTransform &other) noexcept {
     using std::swap;
+    auto &first  = *this;
+    auto &second = other;
     swap(first.parent_, second.parent_);
-    swap(first.parentIt_, second.parentIt_);
-    swap(first.children_, second.children_);
+    swap(first.firstChild_, second.firstChild_);
+    swap(first.prevSibling_, second.prevSibling_);
+    swap(first.nextSibling_, second.nextSibling_);
     swap(first.locals_, second.locals_);
-    swap(first.cachedLocalToWorld_, second.cachedLocalToWorld_);
-    swap(first.cachedWorldToLocal_, second.cachedWorldToLocal_);
-    swap(first.cachedWorldProps_, second.cachedWorldProps_);
-    for (auto child : first.children_) {
-        child->parent_ = &first;
+    swap(first.cache_, second.cache_);
+    swap(first.parentGeneration_, second.parentGeneration_);
+    swap(first.frozen_, second.frozen_);
+    for (auto [node, peer] : {std::pair{&first, &second}, std::pair{&second, &first}}) {
+        // Adjacent siblings end up pointing at themselves after the swap.
+        if (node->prevSibling_ == node) node->prevSibling_ = peer;
+        if (node->nextSibling_ == node) node->nextSibling_ = peer;
     }
-    for (auto child : second.children_) {
-        child->parent_ = &second;
+    for (auto node : {&first, &second}) {
+        for (auto child = node->firstChild_; child; child = child->nextSibling_) {
+            child->parent_ = node;
+        }
+        if (node->prevSibling_) {
+            node->prevSibling_->nextSibling_ = node;
+        } else if (node->parent_) {
+            node->parent_->firstChild_ = node;
+        }
+        if (node->nextSibling_) {
+            node->nextSibling_->prevSibling_ = node;
+        }
+        // A bake follows the state it froze, which now lives here along with its cache.
+        if (node->frozen_) {
+            node->cache_->bake->transforms_[node->cache_->bakeSlot] = node;
+        }
     }
-    if (first.parent_) {
-        *first.parentIt_ = &first;
+    // Each node now holds the other's state, so advance both generations past either's old one to
+    // keep anything derived from them, such as a Camera's view, from mistaking the new state for
+    // the old.
+    auto generation = std::max(first.generation_, second.generation_);
+    for (auto node : {&first, &second}) {
+        node->generation_ = generation;
+        node->invalidateCache();
+        node->invalidateBounds();
     }
-    if (second.parent_) {
-        *second.parentIt_ = &second;
+    swapJournals(other);
+}
+
+template<typename T>
+void
+BasicTransform<T>::checkNotFrozen() const {
+    if (frozen_) {
+        throw std::logic_error("Transform is frozen by a TransformBake");
     }
 }
 
+template<typename T>
 void
-Transform::invalidateCache() const {
-    cachedLocalToWorld_.reset();
-    cachedWorldToLocal_.reset();
-    cachedWorldProps_.reset();
-    for (auto child : children_) {
-        // Don't need to invalidate children's cache if they've already been invalidated
-        if (child->cachedLocalToWorld_ || child->cachedWorldToLocal_ || child->cachedWorldProps_) {
-            child->invalidateCache();
+BasicTransform<T>::swapJournals(BasicTransform &other) noexcept {
+    std::swap(journal_, other.journal_);
+    std::swap(journalSlot_, other.journalSlot_);
+    for (auto node : {this, &other}) {
+        if (node->journal_) {
+            node->journal_->entries_[node->journalSlot_].transform = node;
         }
     }
 }
 
+template<typename T>
 void
-Transform::addChild(Transform *child) {
-    children_.push_back(child);
-    child->parentIt_ = --children_.end();
+BasicTransform<T>::invalidateCache() const {
+    if (cache_) {
+        cache_->localToWorld.reset();
+        cache_->worldToLocal.reset();
+        cache_->worldProps.reset();
+        cache_->subtreeBounds.reset();
+    }
+    generation_++;
 }
 
-Transform &
-Transform::setParent(Transform *parent, bool preserveLocalSpace) {
+template<typename T>
+void
+BasicTransform<T>::markChanged() {
+    invalidateCache();
+    invalidateBounds();
+    if (journal_) {
+        journal_->record(journalSlot_);
+    }
+}
+
+template<typename T>
+void
+BasicTransform<T>::invalidateBounds() const {
+    if (cache_) {
+        cache_->subtreeBounds.reset();
+    }
+    // Bounds are only ever cached on top of cached bounds for every child, so an ancestor without
+    // any means that nothing above it has any either.
+    for (auto node = parent_; node && node->cache_ && node->cache_->subtreeBounds;
+         node      = node->parent_) {
+        node->cache_->subtreeBounds.reset();
+    }
+}
+
+template<typename T>
+typename BasicTransform<T>::Cache &
+BasicTransform<T>::cache() const {
+    if (!cache_) {
+        cache_ = std::make_unique<Cache>();
+    }
+    return *cache_;
+}
+
+template<typename T>
+void
+BasicTransform<T>::validateCache() const {
+    if (!parent_) return;
+    parent_->validateCache();
+    if (parentGeneration_ != parent_->generation_) {
+        // The parent has changed since our caches were built from it.
+        invalidateCache();
+        parentGeneration_ = parent_->generation_;
+    }
+}
+
+template<typename T>
+void
+BasicTransform<T>::updateFromParent() const {
+    if (parent_ && parentGeneration_ != parent_->generation_) {
+        invalidateCache();
+        parentGeneration_ = parent_->generation_;
+    }
+    cachedLocalToWorld();
+}
+
+template<typename T>
+const typename BasicTransform<T>::Mat4 &
+BasicTransform<T>::cachedLocalToWorld() const {
+    auto &cached = cache().localToWorld;
+    if (!cached) {
+        Mat4 mat = localToParentMatrix();
+        if (parent_) {
+            mat = parent_->cachedLocalToWorld() * mat;
+        }
+        cached = mat;
+    }
+    return *cached;
+}
+
+template<typename T>
+const typename BasicTransform<T>::Mat4 &
+BasicTransform<T>::cachedWorldToLocal() const {
+    auto &cached = cache().worldToLocal;
+    if (!cached) {
+        // Inverting the cached matrix is cheaper than walking the ancestors a second time, and
+        // usually reuses work, since both matrices tend to be needed together.
+        cached = affineInverse(cachedLocalToWorld());
+    }
+    return *cached;
+}
+
+template<typename T>
+const typename BasicTransform<T>::Properties &
+BasicTransform<T>::cachedWorldProps() const {
+    if (!composeWorldProps()) {
+        cache().worldProps = decompose(cachedLocalToWorld());
+    }
+    return *cache_->worldProps;
+}
+
+template<typename T>
+bool
+BasicTransform<T>::composeWorldProps() const {
+    if (cache_ && cache_->worldProps) return true;
+    // decompose() always returns positive y and z scales, so anything else would have to be
+    // decomposed to come out in the same form.
+    auto parent = parentSimilarity();
+    if (!parent || locals_.scale.y <= 0 || locals_.scale.z <= 0) return false;
+    // A uniform scale commutes with rotation, so the parent's rotation and scale pass straight
+    // through to the child's, and its skew is left as it is.
+    cache().worldProps = Properties{
+        parent->translation + parent->rotation * (parent->scale.x * locals_.translation),
+        glm::normalize(parent->rotation * locals_.rotation),
+        parent->scale.x * locals_.scale,
+        locals_.skew};
+    return true;
+}
+
+template<typename T>
+typename BasicTransform<T>::Properties
+BasicTransform<T>::relativeToSimilarity(const Properties &similarity, const Properties &world) {
+    auto inverseRotation = glm::conjugate(similarity.rotation);
+    auto inverseScale    = 1 / similarity.scale.x;
+    return {
+        inverseRotation * (world.translation - similarity.translation) * inverseScale,
+        inverseRotation * world.rotation,
+        world.scale * inverseScale,
+        world.skew};
+}
+
+template<typename T>
+typename BasicTransform<T>::Properties
+BasicTransform<T>::localPropertiesUnder(const BasicTransform *parent) const {
+    validateCache();
+    if (parent) {
+        parent->validateCache();
+    }
+    if (auto similarity = similarityOf(parent); similarity && composeWorldProps()) {
+        return relativeToSimilarity(*similarity, *cache_->worldProps);
+    }
+    auto mat = cachedLocalToWorld();
+    if (parent) {
+        mat = parent->cachedWorldToLocal() * mat;
+    }
+    return decompose(mat);
+}
+
+template<typename T>
+void
+BasicTransform<T>::addChild(BasicTransform *child) {
+    invalidateBounds();
+    child->prevSibling_ = nullptr;
+    child->nextSibling_ = firstChild_;
+    if (firstChild_) {
+        firstChild_->prevSibling_ = child;
+    }
+    firstChild_ = child;
+}
+
+template<typename T>
+void
+BasicTransform<T>::removeChild(BasicTransform *child) {
+    invalidateBounds();
+    if (child->prevSibling_) {
+        child->prevSibling_->nextSibling_ = child->nextSibling_;
+    } else {
+        firstChild_ = child->nextSibling_;
+    }
+    if (child->nextSibling_) {
+        child->nextSibling_->prevSibling_ = child->prevSibling_;
+    }
+    child->prevSibling_ = nullptr;
+    child->nextSibling_ = nullptr;
+}
+
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::setParent(BasicTransform *parent, bool preserveLocalSpace) {
+    checkNotFrozen();
     if (parent == parent_) return *this;
     // Check if parent will create a cycle
     for (auto curr = parent; curr; curr = curr->parent_) {
@@ -246,279 +761,715 @@ Transform::setParent(Transform *parent, bool preserveLocalSpace) {
         }
     }
     if (!preserveLocalSpace) {
-        // Get the current world transformation
-        auto mat = localToWorldMatrix();
-        if (parent) {
-            // Remove the new parent's transformation from the matrix;
-            mat = parent->worldToLocalMatrix() * mat;
-        }
-        locals_ = decompose(mat);
+        locals_ = localPropertiesUnder(parent);
     }
     if (parent_) {
-        parent_->children_.erase(parentIt_);
+        parent_->removeChild(this);
     }
     parent_ = parent;
     if (parent_) {
         parent_->addChild(this);
     }
-    invalidateCache();
+    markChanged();
     return *this;
 }
 
-Transform &
-Transform::setPosition(glm::dvec3 position) {
-    auto props         = decompose(localToWorldMatrix());
-    props.translation  = position;
+template<typename T>
+std::optional<typename BasicTransform<T>::Properties>
+BasicTransform<T>::parentSimilarity() const {
+    return similarityOf(parent_);
+}
+
+template<typename T>
+std::optional<typename BasicTransform<T>::Properties>
+BasicTransform<T>::similarityOf(const BasicTransform *transform) {
+    if (!transform) return Properties{};
+    const auto &props = transform->cachedWorldProps();
+    // Decomposing an exact similarity leaves a few ulps of noise in the scale and skew.
+    auto tolerance = 256 * std::numeric_limits<T>::epsilon() * glm::abs(props.scale.x);
+    if (props.scale.x <= 0) return std::nullopt;
+    if (glm::abs(props.scale.y - props.scale.x) > tolerance) return std::nullopt;
+    if (glm::abs(props.scale.z - props.scale.x) > tolerance) return std::nullopt;
+    if (glm::any(glm::greaterThan(glm::abs(props.skew), Vec3(tolerance)))) return std::nullopt;
+    return props;
+}
+
+template<typename T>
+template<typename V>
+BasicTransform<T> &
+BasicTransform<T>::setWorldProperty(V Properties::*member, V value) {
+    auto props         = decompose(cachedLocalToWorld());
+    props.*member      = value;
     auto localToWorld  = recompose(props);
     auto localToParent = localToWorld;
     if (parent_) {
-        localToParent = parent_->worldToLocalMatrix() * localToParent;
+        localToParent = parent_->cachedWorldToLocal() * localToParent;
+    }
+    locals_.*member = decompose(localToParent).*member;
+    markChanged();
+    cache().localToWorld = localToWorld;
+    cache_->worldProps   = props;
+    return *this;
+}
+
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::setPosition(Vec3 position) {
+    checkNotFrozen();
+    validateCache();
+    // Only the translation column of the world matrix changes, so the new local translation is
+    // just the world position brought into the parent's space.
+    auto localPosition = position;
+    if (parent_) {
+        localPosition = Vec3(parent_->cachedWorldToLocal() * Vec4(position, 1));
+    }
+    std::optional<Mat4>       localToWorld;
+    std::optional<Properties> worldProps;
+    if (cache_) {
+        localToWorld = cache_->localToWorld;
+        worldProps   = cache_->worldProps;
+    }
+    locals_.translation = localPosition;
+    markChanged();
+    if (localToWorld) {
+        (*localToWorld)[3]   = Vec4(position, 1);
+        cache_->localToWorld = localToWorld;
+    }
+    if (worldProps) {
+        worldProps->translation = position;
+        cache_->worldProps      = worldProps;
     }
-    locals_.translation = decompose(localToParent).translation;
-    invalidateCache();
-    cachedLocalToWorld_ = localToWorld;
-    cachedWorldProps_   = props;
     return *this;
 }
 
-Transform &
-Transform::setLocalPosition(glm::dvec3 localPosition) {
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::setLocalPosition(Vec3 localPosition) {
+    checkNotFrozen();
     if (localPosition == locals_.translation) {
         return *this;
     }
     locals_.translation = localPosition;
-    invalidateCache();
+    markChanged();
     return *this;
 }
 
-Transform &
-Transform::setRotation(glm::dquat rotation) {
-    auto props         = decompose(localToWorldMatrix());
-    props.rotation     = rotation;
-    auto localToWorld  = recompose(props);
-    auto localToParent = localToWorld;
-    if (parent_) {
-        localToParent = parent_->worldToLocalMatrix() * localToParent;
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::setRotation(Quat rotation) {
+    checkNotFrozen();
+    validateCache();
+    if (auto parent = parentSimilarity()) {
+        locals_.rotation = glm::normalize(glm::conjugate(parent->rotation) * rotation);
+        markChanged();
+        return *this;
     }
-    locals_.rotation = decompose(localToParent).rotation;
-    invalidateCache();
-    cachedLocalToWorld_ = localToWorld;
-    cachedWorldProps_   = props;
-    return *this;
+    return setWorldProperty(&Properties::rotation, rotation);
 }
 
-Transform &
-Transform::setLocalRotation(glm::dquat localRotation) {
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::setLocalRotation(Quat localRotation) {
+    checkNotFrozen();
     if (localRotation == locals_.rotation) {
         return *this;
     }
     locals_.rotation = glm::normalize(localRotation);
-    invalidateCache();
+    markChanged();
     return *this;
 }
 
-Transform &
-Transform::setScale(glm::dvec3 scale) {
-    auto props         = decompose(localToWorldMatrix());
-    props.scale        = scale;
-    auto localToWorld  = recompose(props);
-    auto localToParent = localToWorld;
-    if (parent_) {
-        localToParent = parent_->worldToLocalMatrix() * localToParent;
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::setScale(Vec3 scale) {
+    checkNotFrozen();
+    validateCache();
+    if (auto parent = parentSimilarity()) {
+        locals_.scale = scale / parent->scale.x;
+        markChanged();
+        return *this;
     }
-    locals_.scale = decompose(localToParent).scale;
-    invalidateCache();
-    cachedLocalToWorld_ = localToWorld;
-    cachedWorldProps_   = props;
-    return *this;
+    return setWorldProperty(&Properties::scale, scale);
 }
 
-Transform &
-Transform::setLocalScale(glm::dvec3 localScale) {
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::setLocalScale(Vec3 localScale) {
+    checkNotFrozen();
     if (localScale == locals_.scale) {
         return *this;
     }
     locals_.scale = localScale;
-    invalidateCache();
+    markChanged();
     return *this;
 }
 
-Transform &
-Transform::setSkew(glm::dvec3 skew) {
-    auto props         = decompose(localToWorldMatrix());
-    props.skew         = skew;
-    auto localToWorld  = recompose(props);
-    auto localToParent = localToWorld;
-    if (parent_) {
-        localToParent = parent_->worldToLocalMatrix() * localToParent;
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::setSkew(Vec3 skew) {
+    checkNotFrozen();
+    validateCache();
+    if (parentSimilarity()) {
+        // Uniform scale and rotation leave skew untouched.
+        locals_.skew = skew;
+        markChanged();
+        return *this;
     }
-    locals_.skew = decompose(localToParent).skew;
-    invalidateCache();
-    cachedLocalToWorld_ = localToWorld;
-    cachedWorldProps_   = props;
-    return *this;
+    return setWorldProperty(&Properties::skew, skew);
 }
 
-Transform &
-Transform::setLocalSkew(glm::dvec3 localSkew) {
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::setLocalSkew(Vec3 localSkew) {
+    checkNotFrozen();
     if (localSkew == locals_.skew) {
         return *this;
     }
     locals_.skew = localSkew;
-    invalidateCache();
+    markChanged();
     return *this;
 }
 
-Transform *
-Transform::parent() const {
+template<typename T>
+BasicTransform<T> *
+BasicTransform<T>::parent() const {
     return parent_;
 }
 
-glm::dvec3
-Transform::position() const {
-    if (cachedWorldProps_) {
-        return cachedWorldProps_->translation;
-    }
-    auto props        = decompose(localToWorldMatrix());
-    cachedWorldProps_ = props;
-    return props.translation;
+template<typename T>
+BasicTransform<T> *
+BasicTransform<T>::firstChild() const {
+    return firstChild_;
+}
+
+template<typename T>
+BasicTransform<T> *
+BasicTransform<T>::nextSibling() const {
+    return nextSibling_;
 }
 
-glm::dvec3
-Transform::localPosition() const {
+template<typename T>
+typename BasicTransform<T>::Vec3
+BasicTransform<T>::position() const {
+    validateCache();
+    return cachedWorldProps().translation;
+}
+
+template<typename T>
+typename BasicTransform<T>::Vec3
+BasicTransform<T>::localPosition() const {
     return locals_.translation;
 }
 
-glm::dquat
-Transform::rotation() const {
-    if (cachedWorldProps_) {
-        return cachedWorldProps_->rotation;
-    }
-    auto props        = decompose(localToWorldMatrix());
-    cachedWorldProps_ = props;
-    return props.rotation;
+template<typename T>
+typename BasicTransform<T>::Quat
+BasicTransform<T>::rotation() const {
+    validateCache();
+    return cachedWorldProps().rotation;
 }
 
-glm::dquat
-Transform::localRotation() const {
+template<typename T>
+typename BasicTransform<T>::Quat
+BasicTransform<T>::localRotation() const {
     return locals_.rotation;
 }
 
-glm::dvec3
-Transform::scale() const {
-    if (cachedWorldProps_) {
-        return cachedWorldProps_->scale;
-    }
-    auto props        = decompose(localToWorldMatrix());
-    cachedWorldProps_ = props;
-    return props.scale;
+template<typename T>
+typename BasicTransform<T>::Vec3
+BasicTransform<T>::scale() const {
+    validateCache();
+    return cachedWorldProps().scale;
 }
 
-glm::dvec3
-Transform::localScale() const {
+template<typename T>
+typename BasicTransform<T>::Vec3
+BasicTransform<T>::localScale() const {
     return locals_.scale;
 }
 
-glm::dvec3
-Transform::skew() const {
-    if (cachedWorldProps_) {
-        return cachedWorldProps_->skew;
-    }
-    auto props        = decompose(localToWorldMatrix());
-    cachedWorldProps_ = props;
-    return props.skew;
+template<typename T>
+typename BasicTransform<T>::Vec3
+BasicTransform<T>::skew() const {
+    validateCache();
+    return cachedWorldProps().skew;
 }
 
-[[nodiscard]] glm::dvec3
-Transform::localSkew() const {
+template<typename T>
+typename BasicTransform<T>::Vec3
+BasicTransform<T>::localSkew() const {
     return locals_.skew;
 }
 
-glm::dvec3
-Transform::right() const {
-    return rotation() * glm::dvec3{1, 0, 0};
+template<typename T>
+typename BasicTransform<T>::Vec3
+BasicTransform<T>::right() const {
+    return rotation() * Vec3{1, 0, 0};
 }
 
-glm::dvec3
-Transform::up() const {
-    return rotation() * glm::dvec3{0, 1, 0};
+template<typename T>
+typename BasicTransform<T>::Vec3
+BasicTransform<T>::up() const {
+    return rotation() * Vec3{0, 1, 0};
 }
 
-glm::dvec3
-Transform::forward() const {
-    return rotation() * glm::dvec3{0, 0, -1};
+template<typename T>
+typename BasicTransform<T>::Vec3
+BasicTransform<T>::forward() const {
+    return rotation() * Vec3{0, 0, -1};
 }
 
-glm::dmat4
-Transform::parentToLocalMatrix() const {
+template<typename T>
+typename BasicTransform<T>::Mat4
+BasicTransform<T>::parentToLocalMatrix() const {
     return recomposeInverse(locals_);
 }
 
-glm::dmat4
-Transform::localToParentMatrix() const {
+template<typename T>
+typename BasicTransform<T>::Mat4
+BasicTransform<T>::localToParentMatrix() const {
     return recompose(locals_);
 }
 
-glm::dmat4
-Transform::worldToLocalMatrix() const {
-    if (cachedWorldToLocal_) {
-        return cachedWorldToLocal_.value();
+template<typename T>
+typename BasicTransform<T>::Mat4
+BasicTransform<T>::worldToLocalMatrix() const {
+    validateCache();
+    return cachedWorldToLocal();
+}
+
+template<typename T>
+typename BasicTransform<T>::Mat4
+BasicTransform<T>::localToWorldMatrix() const {
+    validateCache();
+    return cachedLocalToWorld();
+}
+
+template<typename T>
+std::uint64_t
+BasicTransform<T>::worldGeneration() const {
+    validateCache();
+    return generation_;
+}
+
+template<typename T>
+void
+BasicTransform<T>::transformPoints(std::span<const Vec3> points, std::span<Vec3> out) const {
+    validateCache();
+    forEachLaneGroup<T>(points, out, AffineLanes<T, 1>(cachedLocalToWorld()));
+}
+
+template<typename T>
+void
+BasicTransform<T>::transformDirections(std::span<const Vec3> directions, std::span<Vec3> out)
+    const {
+    validateCache();
+    forEachLaneGroup<T>(directions, out, AffineLanes<T, 0>(cachedLocalToWorld()));
+}
+
+template<typename T>
+void
+BasicTransform<T>::inverseTransformPoints(std::span<const Vec3> points, std::span<Vec3> out)
+    const {
+    validateCache();
+    forEachLaneGroup<T>(points, out, AffineLanes<T, 1>(cachedWorldToLocal()));
+}
+
+/***
+ * Transform a sphere by an affine matrix. Under non-uniform scale or skew the sphere becomes an
+ * ellipsoid, so the radius is scaled by a bound on the matrix's largest stretch: the square root of
+ * the largest absolute row sum of its upper 3x3's Gram matrix, which is at least its largest
+ * eigenvalue, and equal to it for similarities.
+ */
+template<typename T>
+static typename BasicTransform<T>::Sphere
+transformSphere(
+    const typename BasicTransform<T>::Mat4   &mat,
+    const typename BasicTransform<T>::Sphere &sphere) {
+    using Vec3 = typename BasicTransform<T>::Vec3;
+    std::array<Vec3, 3> cols{Vec3(mat[0]), Vec3(mat[1]), Vec3(mat[2])};
+    T                   stretch = 0;
+    for (int i = 0; i < 3; i++) {
+        T sum = 0;
+        for (int j = 0; j < 3; j++) {
+            sum += glm::abs(glm::dot(cols[i], cols[j]));
+        }
+        stretch = std::max(stretch, sum);
     }
-    glm::dmat4 mat = parentToLocalMatrix();
-    if (parent_) {
-        mat = mat * parent_->worldToLocalMatrix();
+    return {Vec3(mat * glm::vec<4, T, glm::defaultp>(sphere.center, 1)),
+            sphere.radius * glm::sqrt(stretch)};
+}
+
+/***
+ * Get the smallest sphere enclosing two others. A sphere with a negative radius is empty.
+ */
+template<typename T>
+static typename BasicTransform<T>::Sphere
+mergeSpheres(
+    const typename BasicTransform<T>::Sphere &a,
+    const typename BasicTransform<T>::Sphere &b) {
+    if (b.radius < 0) return a;
+    if (a.radius < 0) return b;
+    auto offset   = b.center - a.center;
+    T    distance = glm::length(offset);
+    if (distance + b.radius <= a.radius) return a;
+    if (distance + a.radius <= b.radius) return b;
+    // Neither contains the other, so the spheres' centers are distinct.
+    T radius = (distance + a.radius + b.radius) / 2;
+    return {a.center + offset * ((radius - a.radius) / distance), radius};
+}
+
+template<typename T>
+BasicTransform<T> &
+BasicTransform<T>::setLocalBounds(std::optional<Sphere> bounds) {
+    if (bounds && !(bounds->radius >= 0)) {
+        throw std::invalid_argument("bounding sphere radius must not be negative");
     }
-    cachedWorldToLocal_ = mat;
-    return mat;
+    if (bounds) {
+        cache().localBounds = bounds;
+    } else if (cache_) {
+        cache_->localBounds.reset();
+    }
+    invalidateBounds();
+    return *this;
+}
+
+template<typename T>
+std::optional<typename BasicTransform<T>::Sphere>
+BasicTransform<T>::localBounds() const {
+    if (!cache_) return std::nullopt;
+    return cache_->localBounds;
 }
-glm::dmat4
-Transform::localToWorldMatrix() const {
-    if (cachedLocalToWorld_) {
-        return cachedLocalToWorld_.value();
+
+template<typename T>
+std::optional<typename BasicTransform<T>::Sphere>
+BasicTransform<T>::subtreeBounds() const {
+    validateCache();
+    auto &bounds = cachedSubtreeBounds();
+    if (bounds.radius < 0) return std::nullopt;
+    return bounds;
+}
+
+template<typename T>
+std::optional<typename BasicTransform<T>::Sphere>
+BasicTransform<T>::worldBounds() const {
+    if (!cache_ || !cache_->localBounds) return std::nullopt;
+    return transformSphere<T>(cachedLocalToWorld(), *cache_->localBounds);
+}
+
+template<typename T>
+const typename BasicTransform<T>::Sphere &
+BasicTransform<T>::cachedSubtreeBounds() const {
+    if (cache_ && cache_->subtreeBounds) return *cache_->subtreeBounds;
+    // Gather every Transform whose bounds were discarded, parents before children. Every
+    // descendant of a Transform whose bounds are still cached has them cached too, so those
+    // branches are skipped entirely.
+    std::vector<const BasicTransform *> stale{this};
+    for (std::size_t i = 0; i < stale.size(); i++) {
+        for (auto child = stale[i]->firstChild_; child; child = child->nextSibling_) {
+            child->updateFromParent();
+            if (!child->cache_->subtreeBounds) stale.push_back(child);
+        }
     }
-    glm::dmat4 mat = localToParentMatrix();
-    if (parent_) {
-        mat = parent_->localToWorldMatrix() * mat;
+    // Rebuild them children first, iteratively, so that deep hierarchies can't overflow the stack.
+    for (auto it = stale.rbegin(); it != stale.rend(); ++it) {
+        auto node   = *it;
+        auto bounds = node->worldBounds().value_or(Sphere{Vec3(0), -1});
+        for (auto child = node->firstChild_; child; child = child->nextSibling_) {
+            bounds = mergeSpheres<T>(bounds, *child->cache_->subtreeBounds);
+        }
+        node->cache().subtreeBounds = bounds;
+    }
+    return *cache_->subtreeBounds;
+}
+
+template<typename T>
+void
+BasicTransform<T>::cull(
+    const Frustum                       &frustum,
+    std::vector<const BasicTransform *> &visible,
+    Vec3                                 origin) const {
+    visible.clear();
+    validateCache();
+    // Afterwards, every Transform in the subtree has up-to-date bounds and matrices cached.
+    cachedSubtreeBounds();
+    auto intersects = [&](const Sphere &sphere) {
+        return frustum.intersectsSphere(
+            glm::vec3(sphere.center - origin),
+            static_cast<float>(sphere.radius));
+    };
+    // Each entry holds a Transform and whether its parent's bounds lie entirely inside the
+    // frustum, in which case so do its own.
+    std::vector<std::pair<const BasicTransform *, bool>> stack{{this, false}};
+    while (!stack.empty()) {
+        auto [node, inside] = stack.back();
+        stack.pop_back();
+        auto &bounds = *node->cache_->subtreeBounds;
+        if (bounds.radius < 0) continue;
+        if (!inside) {
+            if (!intersects(bounds)) continue;
+            inside = frustum.containsSphere(
+                glm::vec3(bounds.center - origin),
+                static_cast<float>(bounds.radius));
+        }
+        // A leaf's subtree bounds are its own, so they have already been tested.
+        if (node->cache_->localBounds &&
+            (inside || !node->firstChild_ || intersects(*node->worldBounds()))) {
+            visible.push_back(node);
+        }
+        for (auto child = node->firstChild_; child; child = child->nextSibling_) {
+            stack.emplace_back(child, inside);
+        }
+    }
+}
+
+template<typename T>
+void
+BasicTransform<T>::updateWorldMatrices() const {
+    validateCache();
+    cachedLocalToWorld();
+    // Depth-first, so that every parent is refreshed before its children.
+    std::vector<const BasicTransform *> stack;
+    for (auto child = firstChild_; child; child = child->nextSibling_) {
+        stack.push_back(child);
     }
-    cachedLocalToWorld_ = mat;
-    return mat;
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+        node->updateFromParent();
+        for (auto child = node->firstChild_; child; child = child->nextSibling_) {
+            stack.push_back(child);
+        }
+    }
+}
+
+// The number of nodes a task must have waiting before it splits some off into a new task.
+static constexpr std::size_t SPLIT_THRESHOLD = 128;
+
+/***
+ * Update the subtrees rooted at each of the given nodes, whose parents must already be up to date.
+ * Whenever enough nodes are waiting to be visited, half of them are handed off to a new task in
+ * the same group, so that wide and deep trees alike spread across the pool.
+ */
+template<typename T, typename Visit>
+static void
+updateSubtrees(std::vector<const T *> stack, ThreadPool::TaskGroup &group, Visit visit) {
+    while (!stack.empty()) {
+        if (stack.size() >= SPLIT_THRESHOLD) {
+            auto half = static_cast<std::ptrdiff_t>(stack.size() / 2);
+            std::vector<const T *> split(stack.begin(), stack.begin() + half);
+            stack.erase(stack.begin(), stack.begin() + half);
+            group.run([split = std::move(split), &group, visit]() mutable {
+                updateSubtrees<T>(std::move(split), group, visit);
+            });
+        }
+        auto node = stack.back();
+        stack.pop_back();
+        visit(node, stack);
+    }
+}
+
+template<typename T>
+void
+BasicTransform<T>::updateWorldMatrices(ThreadPool &pool) const {
+    validateCache();
+    cachedLocalToWorld();
+    std::vector<const BasicTransform *> roots;
+    for (auto child = firstChild_; child; child = child->nextSibling_) {
+        roots.push_back(child);
+    }
+    // Each task only writes to the nodes it visits, and only reads from their parents, which were
+    // finished before the node was queued.
+    auto visit = [](const BasicTransform *node, std::vector<const BasicTransform *> &stack) {
+        node->updateFromParent();
+        for (auto child = node->firstChild_; child; child = child->nextSibling_) {
+            stack.push_back(child);
+        }
+    };
+    ThreadPool::TaskGroup group(pool);
+    updateSubtrees<BasicTransform>(std::move(roots), group, visit);
+    group.wait();
+}
+
+template<typename T>
+BasicTransformBake<T>
+BasicTransform<T>::bake() {
+    return BasicTransformBake<T>(*this);
 }
 
-Transform::Builder &
-Transform::Builder::withParent(Transform &parent) {
+template<typename T>
+bool
+BasicTransform<T>::frozen() const {
+    return frozen_;
+}
+
+template<typename T>
+typename BasicTransform<T>::Builder &
+BasicTransform<T>::Builder::withParent(BasicTransform &parent) {
     parent_ = &parent;
     return *this;
 }
 
-Transform::Builder &
-Transform::Builder::withPosition(glm::dvec3 position) {
+template<typename T>
+typename BasicTransform<T>::Builder &
+BasicTransform<T>::Builder::withPosition(Vec3 position) {
     position_ = position;
     return *this;
 }
 
-Transform::Builder &
-Transform::Builder::withRotation(glm::dquat rotation) {
+template<typename T>
+typename BasicTransform<T>::Builder &
+BasicTransform<T>::Builder::withRotation(Quat rotation) {
     rotation_ = rotation;
     return *this;
 }
 
-Transform::Builder &
-Transform::Builder::withScale(glm::dvec3 scale) {
+template<typename T>
+typename BasicTransform<T>::Builder &
+BasicTransform<T>::Builder::withScale(Vec3 scale) {
     scale_ = scale;
     return *this;
 }
 
-Transform::Builder &
-Transform::Builder::withSkew(glm::dvec3 skew) {
+template<typename T>
+typename BasicTransform<T>::Builder &
+BasicTransform<T>::Builder::withSkew(Vec3 skew) {
     skew_ = skew;
     return *this;
 }
 
-Transform
-Transform::Builder::build() const {
-    return Transform(parent_, Transform::Properties{position_, rotation_, scale_, skew_});
+template<typename T>
+BasicTransform<T>
+BasicTransform<T>::Builder::build() const {
+    return BasicTransform(parent_, Properties{position_, rotation_, scale_, skew_});
 }
 
-Transform::Builder::operator Transform() const {
+template<typename T>
+BasicTransform<T>::Builder::operator BasicTransform() const {
     return build();
 }
+
+template<typename T>
+typename BasicTransform<T>::Edit &
+BasicTransform<T>::Edit::setParent(
+    BasicTransform &child,
+    BasicTransform *parent,
+    bool            preserveLocalSpace) {
+    reparents_.push_back({&child, parent, preserveLocalSpace});
+    return *this;
+}
+
+template<typename T>
+void
+BasicTransform<T>::Edit::commit() {
+    auto reparents = std::exchange(reparents_, {});
+    // Keep only the last change to each child, and drop any that wouldn't change anything.
+    std::unordered_map<const BasicTransform *, BasicTransform *> newParents;
+    std::vector<Reparent>                                        changes;
+    newParents.reserve(reparents.size());
+    for (auto it = reparents.rbegin(); it != reparents.rend(); ++it) {
+        if (newParents.emplace(it->child, it->parent).second && it->child->parent_ != it->parent) {
+            changes.push_back(*it);
+        }
+    }
+    std::reverse(changes.begin(), changes.end());
+    for (auto &change : changes) {
+        change.child->checkNotFrozen();
+    }
+
+    // Walk up the final hierarchy from every changed child, recording which walk first reached
+    // each node. Reaching a node from an earlier walk means the rest of the way up is already
+    // known to be acyclic, so each node is visited once.
+    std::unordered_map<const BasicTransform *, std::size_t> visitedBy;
+    visitedBy.reserve(changes.size());
+    for (std::size_t walk = 0; walk < changes.size(); walk++) {
+        for (const BasicTransform *curr = changes[walk].child; curr;) {
+            auto [found, inserted] = visitedBy.emplace(curr, walk);
+            if (!inserted) {
+                if (found->second == walk) {
+                    throw std::invalid_argument("Committing edit would create a cycle");
+                }
+                break;
+            }
+            auto parent = newParents.find(curr);
+            curr        = parent == newParents.end() ? curr->parent_ : parent->second;
+        }
+    }
+
+    // World-preserving changes keep the world placements from before any link was changed, as
+    // properties when they can be had without decomposing a matrix, or as matrices otherwise.
+    struct World {
+        std::optional<Properties> props;
+        Mat4                      matrix;
+    };
+    std::vector<World> worlds(changes.size());
+    for (std::size_t i = 0; i < changes.size(); i++) {
+        if (changes[i].preserveLocalSpace) continue;
+        auto *child = changes[i].child;
+        child->validateCache();
+        if (child->composeWorldProps()) {
+            worlds[i].props = child->cache_->worldProps;
+        } else {
+            worlds[i].matrix = child->cachedLocalToWorld();
+        }
+    }
+    for (auto &change : changes) {
+        auto *child = change.child;
+        if (child->parent_) {
+            child->parent_->removeChild(child);
+        }
+        child->parent_ = change.parent;
+        if (child->parent_) {
+            child->parent_->addChild(child);
+        }
+        child->markChanged();
+    }
+
+    // Re-derive local properties parents-first, so that each new parent's world matrix is final
+    // by the time its children are decomposed against it.
+    std::unordered_map<const BasicTransform *, std::size_t> depths;
+    std::vector<const BasicTransform *>                     unknown;
+    depths.reserve(changes.size());
+
+    auto depthOf = [&](const BasicTransform *node) {
+        std::size_t depth = 0;
+        for (; node; node = node->parent_) {
+            if (auto found = depths.find(node); found != depths.end()) {
+                depth = found->second;
+                break;
+            }
+            unknown.push_back(node);
+        }
+        for (auto it = unknown.rbegin(); it != unknown.rend(); ++it) {
+            depths[*it] = ++depth;
+        }
+        unknown.clear();
+        return depth;
+    };
+    std::vector<std::pair<std::size_t, std::size_t>> order;
+    for (std::size_t i = 0; i < changes.size(); i++) {
+        if (!changes[i].preserveLocalSpace) order.emplace_back(depthOf(changes[i].child), i);
+    }
+    std::sort(order.begin(), order.end());
+    for (auto [depth, i] : order) {
+        auto *child = changes[i].child;
+        auto &world = worlds[i];
+        if (child->parent_) {
+            child->parent_->validateCache();
+        }
+        auto similarity = similarityOf(child->parent_);
+        if (world.props && similarity) {
+            child->locals_ = relativeToSimilarity(*similarity, *world.props);
+        } else {
+            auto local = world.props ? recompose(*world.props) : world.matrix;
+            if (child->parent_) {
+                local = child->parent_->cachedWorldToLocal() * local;
+            }
+            child->locals_ = decompose(local);
+        }
+        child->markChanged();
+    }
+}
+
+
+template class BasicTransform<float>;
+template class BasicTransform<double>;
@@ -0,0 +1,116 @@
+//
+// Created by taylor-santos on 10/17/2026 at 02:14.
+//
+
+#include "transform_bake.h"
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+template<typename T>
+BasicTransformBake<T>::BasicTransformBake(Transform &root) {
+    if (root.parent()) {
+        throw std::invalid_argument("Only a root Transform can be baked");
+    }
+    // Gather the hierarchy with every parent before its children.
+    transforms_.push_back(&root);
+    for (std::size_t i = 0; i < transforms_.size(); i++) {
+        for (auto *child = transforms_[i]->firstChild(); child; child = child->nextSibling()) {
+            transforms_.push_back(child);
+        }
+    }
+    for (auto *transform : transforms_) {
+        if (transform->frozen_) {
+            transforms_.clear();
+            throw std::logic_error("Transform is already frozen by another TransformBake");
+        }
+    }
+    root.updateWorldMatrices();
+    matrices_.reserve(transforms_.size());
+    for (std::size_t i = 0; i < transforms_.size(); i++) {
+        auto *transform    = transforms_[i];
+        transform->frozen_ = true;
+        matrices_.push_back(transform->localToWorldMatrix());
+        transform->cache().bake     = this;
+        transform->cache().bakeSlot = i;
+    }
+}
+
+template<typename T>
+BasicTransformBake<T>::~BasicTransformBake() {
+    unfreeze();
+}
+
+template<typename T>
+BasicTransformBake<T>::BasicTransformBake(BasicTransformBake &&other) noexcept
+    : transforms_{std::move(other.transforms_)}
+    , matrices_{std::move(other.matrices_)} {
+    other.transforms_.clear();
+    other.matrices_.clear();
+    for (auto *transform : transforms_) {
+        transform->cache().bake = this;
+    }
+}
+
+template<typename T>
+BasicTransformBake<T> &
+BasicTransformBake<T>::operator=(BasicTransformBake &&other) noexcept {
+    if (this != &other) {
+        unfreeze();
+        transforms_ = std::move(other.transforms_);
+        matrices_   = std::move(other.matrices_);
+        other.transforms_.clear();
+        other.matrices_.clear();
+        for (auto *transform : transforms_) {
+            transform->cache().bake = this;
+        }
+    }
+    return *this;
+}
+
+template<typename T>
+std::span<const typename BasicTransformBake<T>::Mat4>
+BasicTransformBake<T>::matrices() const {
+    return matrices_;
+}
+
+template<typename T>
+std::span<typename BasicTransformBake<T>::Transform *const>
+BasicTransformBake<T>::transforms() const {
+    return transforms_;
+}
+
+template<typename T>
+std::size_t
+BasicTransformBake<T>::size() const {
+    return transforms_.size();
+}
+
+template<typename T>
+void
+BasicTransformBake<T>::unfreeze() {
+    for (auto *transform : transforms_) {
+        transform->frozen_      = false;
+        transform->cache().bake = nullptr;
+    }
+    transforms_.clear();
+    matrices_.clear();
+}
+
+template<typename T>
+void
+BasicTransformBake<T>::forget(const Transform *transform) {
+    // Move the last Transform into the forgotten one's place, so that tearing down a whole baked
+    // hierarchy, in whatever order, takes linear time.
+    auto slot = transform->cache_->bakeSlot;
+    assert(slot < transforms_.size() && transforms_[slot] == transform);
+    transforms_[slot] = transforms_.back();
+    matrices_[slot]   = matrices_.back();
+    transforms_[slot]->cache_->bakeSlot = slot;
+    transforms_.pop_back();
+    matrices_.pop_back();
+}
+
+template class BasicTransformBake<float>;
+template class BasicTransformBake<double>;
@@ -0,0 +1,437 @@
+//
+// Created by taylor-santos on 10/16/2026 at 19:52.
+//
+
+#include "transform_hierarchy.h"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+
+TransformHierarchy::View::View(TransformHierarchy *hierarchy, Id id)
+    : hierarchy_{hierarchy}
+    , id_{id} {}
+
+TransformHierarchy::Id
+TransformHierarchy::View::id() const {
+    return id_;
+}
+
+TransformHierarchy::View::operator bool() const {
+    return hierarchy_ && hierarchy_->contains(id_);
+}
+
+bool
+TransformHierarchy::View::operator==(const View &other) const {
+    return hierarchy_ == other.hierarchy_ && id_ == other.id_;
+}
+
+std::uint32_t
+TransformHierarchy::View::index() const {
+    if (!*this) {
+        throw std::out_of_range("View does not refer to a node in a TransformHierarchy");
+    }
+    return hierarchy_->indices_[id_];
+}
+
+template<typename T>
+TransformHierarchy::View &
+TransformHierarchy::View::setWorld(T Transform::Properties::*member, T value) {
+    auto idx   = index();
+    auto props = Transform::decompose(hierarchy_->worldMatrix(idx));
+    props.*member      = value;
+    auto localToParent = Transform::recompose(props);
+    auto parent        = hierarchy_->parents_[idx];
+    if (parent != NONE) {
+        localToParent = Transform::affineInverse(hierarchy_->worldMatrix(parent)) * localToParent;
+    }
+    hierarchy_->locals_[idx].*member = Transform::decompose(localToParent).*member;
+    hierarchy_->markDirty(idx);
+    return *this;
+}
+
+TransformHierarchy::View &
+TransformHierarchy::View::setParent(View parent, bool preserveLocalSpace) {
+    auto idx = index();
+    if (parent && parent.hierarchy_ != hierarchy_) {
+        throw std::invalid_argument("Parent belongs to a different TransformHierarchy");
+    }
+    auto  parentIdx = parent ? parent.index() : NONE;
+    auto &parents   = hierarchy_->parents_;
+    if (parentIdx == parents[idx]) return *this;
+    // Check if parent will create a cycle
+    for (auto curr = parentIdx; curr != NONE; curr = parents[curr]) {
+        if (curr == idx) {
+            throw std::invalid_argument("Setting transform's parent would create a cycle");
+        }
+    }
+    if (!preserveLocalSpace) {
+        // Get the current world transformation
+        auto mat = hierarchy_->worldMatrix(idx);
+        if (parentIdx != NONE) {
+            // Remove the new parent's transformation from the matrix
+            mat = Transform::affineInverse(hierarchy_->worldMatrix(parentIdx)) * mat;
+        }
+        hierarchy_->locals_[idx] = Transform::decompose(mat);
+    }
+    parents[idx] = parentIdx;
+    if (parentIdx != NONE && parentIdx > idx) {
+        hierarchy_->unsorted_ = true;
+    }
+    hierarchy_->markDirty(idx);
+    return *this;
+}
+
+TransformHierarchy::View &
+TransformHierarchy::View::setPosition(glm::dvec3 position) {
+    return setWorld(&Transform::Properties::translation, position);
+}
+
+TransformHierarchy::View &
+TransformHierarchy::View::setLocalPosition(glm::dvec3 localPosition) {
+    auto idx                             = index();
+    hierarchy_->locals_[idx].translation = localPosition;
+    hierarchy_->markDirty(idx);
+    return *this;
+}
+
+TransformHierarchy::View &
+TransformHierarchy::View::setRotation(glm::dquat rotation) {
+    return setWorld(&Transform::Properties::rotation, rotation);
+}
+
+TransformHierarchy::View &
+TransformHierarchy::View::setLocalRotation(glm::dquat localRotation) {
+    auto idx                          = index();
+    hierarchy_->locals_[idx].rotation = glm::normalize(localRotation);
+    hierarchy_->markDirty(idx);
+    return *this;
+}
+
+TransformHierarchy::View &
+TransformHierarchy::View::setScale(glm::dvec3 scale) {
+    return setWorld(&Transform::Properties::scale, scale);
+}
+
+TransformHierarchy::View &
+TransformHierarchy::View::setLocalScale(glm::dvec3 localScale) {
+    auto idx                       = index();
+    hierarchy_->locals_[idx].scale = localScale;
+    hierarchy_->markDirty(idx);
+    return *this;
+}
+
+TransformHierarchy::View &
+TransformHierarchy::View::setSkew(glm::dvec3 skew) {
+    return setWorld(&Transform::Properties::skew, skew);
+}
+
+TransformHierarchy::View &
+TransformHierarchy::View::setLocalSkew(glm::dvec3 localSkew) {
+    auto idx                      = index();
+    hierarchy_->locals_[idx].skew = localSkew;
+    hierarchy_->markDirty(idx);
+    return *this;
+}
+
+TransformHierarchy::View
+TransformHierarchy::View::parent() const {
+    auto idx       = index();
+    auto parentIdx = hierarchy_->parents_[idx];
+    if (parentIdx == NONE) return {};
+    return {hierarchy_, hierarchy_->ids_[parentIdx]};
+}
+
+glm::dvec3
+TransformHierarchy::View::position() const {
+    return Transform::decompose(localToWorldMatrix()).translation;
+}
+
+glm::dvec3
+TransformHierarchy::View::localPosition() const {
+    auto idx = index();
+    return hierarchy_->locals_[idx].translation;
+}
+
+glm::dquat
+TransformHierarchy::View::rotation() const {
+    return Transform::decompose(localToWorldMatrix()).rotation;
+}
+
+glm::dquat
+TransformHierarchy::View::localRotation() const {
+    auto idx = index();
+    return hierarchy_->locals_[idx].rotation;
+}
+
+glm::dvec3
+TransformHierarchy::View::scale() const {
+    return Transform::decompose(localToWorldMatrix()).scale;
+}
+
+glm::dvec3
+TransformHierarchy::View::localScale() const {
+    auto idx = index();
+    return hierarchy_->locals_[idx].scale;
+}
+
+glm::dvec3
+TransformHierarchy::View::skew() const {
+    return Transform::decompose(localToWorldMatrix()).skew;
+}
+
+glm::dvec3
+TransformHierarchy::View::localSkew() const {
+    auto idx = index();
+    return hierarchy_->locals_[idx].skew;
+}
+
+glm::dvec3
+TransformHierarchy::View::right() const {
+    return rotation() * glm::dvec3{1, 0, 0};
+}
+
+glm::dvec3
+TransformHierarchy::View::up() const {
+    return rotation() * glm::dvec3{0, 1, 0};
+}
+
+glm::dvec3
+TransformHierarchy::View::forward() const {
+    return rotation() * glm::dvec3{0, 0, -1};
+}
+
+glm::dmat4
+TransformHierarchy::View::parentToLocalMatrix() const {
+    auto idx = index();
+    return Transform::recomposeInverse(hierarchy_->locals_[idx]);
+}
+
+glm::dmat4
+TransformHierarchy::View::localToParentMatrix() const {
+    auto idx = index();
+    return Transform::recompose(hierarchy_->locals_[idx]);
+}
+
+glm::dmat4
+TransformHierarchy::View::worldToLocalMatrix() const {
+    return Transform::affineInverse(localToWorldMatrix());
+}
+
+glm::dmat4
+TransformHierarchy::View::localToWorldMatrix() const {
+    auto idx = index();
+    return hierarchy_->worldMatrix(idx);
+}
+
+TransformHierarchy::View
+TransformHierarchy::create(const Transform::Properties &locals) {
+    return create(View{}, locals);
+}
+
+TransformHierarchy::View
+TransformHierarchy::create(View parent, const Transform::Properties &locals) {
+    if (parent && parent.hierarchy_ != this) {
+        throw std::invalid_argument("Parent belongs to a different TransformHierarchy");
+    }
+    // Appending keeps the arrays sorted, as the parent must already be somewhere before the end.
+    auto parentIdx = parent ? parent.index() : NONE;
+    auto idx       = static_cast<std::uint32_t>(locals_.size());
+    Id   id;
+    if (freeIds_.empty()) {
+        id = static_cast<Id>(indices_.size());
+        indices_.push_back(idx);
+    } else {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+        indices_[id] = idx;
+    }
+    locals_.push_back(locals);
+    parents_.push_back(parentIdx);
+    worlds_.emplace_back(1);
+    dirty_.push_back(0);
+    ids_.push_back(id);
+    markDirty(idx);
+    return {this, id};
+}
+
+void
+TransformHierarchy::destroy(View node) {
+    auto idx = node.index();
+    // Readjust children's local properties to keep them fixed in world space. They all share the
+    // destroyed node's world matrix, so it is only found once.
+    std::optional<glm::dmat4> world;
+    for (std::uint32_t i = 0; i < parents_.size(); i++) {
+        if (parents_[i] == idx) {
+            if (!world) world = worldMatrix(idx);
+            locals_[i]  = Transform::decompose(*world * Transform::recompose(locals_[i]));
+            parents_[i] = NONE;
+            markDirty(i);
+        }
+    }
+    locals_.erase(locals_.begin() + idx);
+    parents_.erase(parents_.begin() + idx);
+    worlds_.erase(worlds_.begin() + idx);
+    dirty_.erase(dirty_.begin() + idx);
+    ids_.erase(ids_.begin() + idx);
+    for (std::uint32_t i = idx; i < ids_.size(); i++) {
+        indices_[ids_[i]] = i;
+    }
+    for (auto &parent : parents_) {
+        if (parent != NONE && parent > idx) parent--;
+    }
+    indices_[node.id_] = NONE;
+    freeIds_.push_back(node.id_);
+}
+
+void
+TransformHierarchy::clear() {
+    locals_.clear();
+    parents_.clear();
+    worlds_.clear();
+    dirty_.clear();
+    ids_.clear();
+    indices_.clear();
+    freeIds_.clear();
+    unsorted_ = false;
+    pending_  = false;
+}
+
+TransformHierarchy::View
+TransformHierarchy::get(Id id) {
+    if (!contains(id)) {
+        throw std::out_of_range("No node in the TransformHierarchy has the given ID");
+    }
+    return {this, id};
+}
+
+bool
+TransformHierarchy::contains(Id id) const {
+    return id < indices_.size() && indices_[id] != NONE;
+}
+
+std::size_t
+TransformHierarchy::size() const {
+    return locals_.size();
+}
+
+void
+TransformHierarchy::updateWorldMatrices() {
+    sort();
+    if (!pending_) return;
+    // Gather every node that needs a new world matrix, so that all of their local matrices can be
+    // recomposed in a single batch.
+    dirtyIndices_.clear();
+    dirtyLocals_.clear();
+    for (std::uint32_t i = 0; i < locals_.size(); i++) {
+        auto parent = parents_[i];
+        // Parents come first, so their dirty flag has already absorbed their own ancestors'.
+        if (parent != NONE) dirty_[i] |= dirty_[parent];
+        if (!dirty_[i]) continue;
+        dirtyIndices_.push_back(i);
+        dirtyLocals_.push_back(locals_[i]);
+    }
+    dirtyMats_.resize(dirtyLocals_.size());
+    Transform::recompose(dirtyLocals_, dirtyMats_);
+    for (std::size_t j = 0; j < dirtyIndices_.size(); j++) {
+        auto i      = dirtyIndices_[j];
+        auto parent = parents_[i];
+        worlds_[i]  = parent == NONE ? dirtyMats_[j] : worlds_[parent] * dirtyMats_[j];
+    }
+    std::fill(dirty_.begin(), dirty_.end(), std::uint8_t{0});
+    pending_ = false;
+}
+
+const std::vector<glm::dmat4> &
+TransformHierarchy::worldMatrices() {
+    updateWorldMatrices();
+    return worlds_;
+}
+
+const std::vector<TransformHierarchy::Id> &
+TransformHierarchy::order() {
+    updateWorldMatrices();
+    return ids_;
+}
+
+void
+TransformHierarchy::markDirty(std::uint32_t index) {
+    dirty_[index] = 1;
+    pending_      = true;
+}
+
+glm::dmat4
+TransformHierarchy::worldMatrix(std::uint32_t index) const {
+    if (!pending_) return worlds_[index];
+    // A stored matrix is only current if neither the node nor any of its ancestors are dirty, so
+    // find the topmost dirty node along the chain, then walk the chain again, composing each local
+    // matrix up to that node onto the left and finishing with its parent's stored world matrix.
+    // Nothing is stored along the way, so reads between a setter and the next update never
+    // allocate.
+    auto top = NONE;
+    for (auto curr = index; curr != NONE; curr = parents_[curr]) {
+        if (dirty_[curr]) top = curr;
+    }
+    if (top == NONE) return worlds_[index];
+    glm::dmat4 result{1};
+    for (auto curr = index;; curr = parents_[curr]) {
+        result = Transform::recompose(locals_[curr]) * result;
+        if (curr == top) break;
+    }
+    auto parent = parents_[top];
+    return parent == NONE ? result : worlds_[parent] * result;
+}
+
+void
+TransformHierarchy::sort() {
+    if (!unsorted_) return;
+    auto n = static_cast<std::uint32_t>(locals_.size());
+
+    // Find the depth of each node, memoizing along the way so that every node is visited once.
+    std::vector<std::uint32_t> depths(n, NONE);
+    std::vector<std::uint32_t> stack;
+    std::uint32_t              maxDepth = 0;
+    for (std::uint32_t i = 0; i < n; i++) {
+        auto curr = i;
+        while (depths[curr] == NONE && parents_[curr] != NONE) {
+            stack.push_back(curr);
+            curr = parents_[curr];
+        }
+        if (depths[curr] == NONE) depths[curr] = 0;
+        auto depth = depths[curr];
+        while (!stack.empty()) {
+            depths[stack.back()] = ++depth;
+            stack.pop_back();
+        }
+        maxDepth = std::max(maxDepth, depths[i]);
+    }
+
+    // Counting sort by depth. Parents are always shallower than their children, and the sort is
+    // stable so siblings keep their relative order.
+    std::vector<std::uint32_t> offsets(maxDepth + 2, 0);
+    for (auto depth : depths) offsets[depth + 1]++;
+    for (std::size_t d = 1; d < offsets.size(); d++) offsets[d] += offsets[d - 1];
+    std::vector<std::uint32_t> newIndices(n);
+    for (std::uint32_t i = 0; i < n; i++) newIndices[i] = offsets[depths[i]]++;
+
+    std::vector<Transform::Properties> locals(n);
+    std::vector<std::uint32_t>         parents(n);
+    std::vector<glm::dmat4>            worlds(n);
+    std::vector<std::uint8_t>          dirty(n);
+    std::vector<Id>                    ids(n);
+    for (std::uint32_t i = 0; i < n; i++) {
+        auto j            = newIndices[i];
+        locals[j]         = locals_[i];
+        parents[j]        = parents_[i] == NONE ? NONE : newIndices[parents_[i]];
+        worlds[j]         = worlds_[i];
+        dirty[j]          = dirty_[i];
+        ids[j]            = ids_[i];
+        indices_[ids_[i]] = j;
+    }
+    locals_   = std::move(locals);
+    parents_  = std::move(parents);
+    worlds_   = std::move(worlds);
+    dirty_    = std::move(dirty);
+    ids_      = std::move(ids);
+    unsorted_ = false;
+}
@@ -0,0 +1,54 @@
+//
+// Created by taylor-santos on 10/17/2026 at 10:20.
+//
+
+#include "transform_interpolation.h"
+
+#include <stdexcept>
+#include <utility>
+
+template<typename T>
+void
+BasicTransformInterpolation<T>::capture(std::span<const Transform *const> transforms) {
+    std::swap(previous_, current_);
+    current_.resize(transforms.size());
+    for (std::size_t i = 0; i < transforms.size(); i++) {
+        auto *transform = transforms[i];
+        current_[i]     = {
+            transform->position(),
+            transform->rotation(),
+            transform->scale(),
+            transform->skew()};
+    }
+    if (previous_.size() != current_.size()) {
+        previous_ = current_;
+    }
+}
+
+template<typename T>
+void
+BasicTransformInterpolation<T>::interpolate(T alpha, std::span<Mat4> out) {
+    if (out.size() != current_.size()) {
+        throw std::invalid_argument("interpolated matrices must match the captured Transforms");
+    }
+    blended_.resize(current_.size());
+    for (std::size_t i = 0; i < current_.size(); i++) {
+        auto &from  = previous_[i];
+        auto &to    = current_[i];
+        blended_[i] = {
+            glm::mix(from.translation, to.translation, alpha),
+            glm::slerp(from.rotation, to.rotation, alpha),
+            glm::mix(from.scale, to.scale, alpha),
+            glm::mix(from.skew, to.skew, alpha)};
+    }
+    Transform::recompose(blended_, out);
+}
+
+template<typename T>
+std::size_t
+BasicTransformInterpolation<T>::size() const {
+    return current_.size();
+}
+
+template class BasicTransformInterpolation<float>;
+template class BasicTransformInterpolation<double>;
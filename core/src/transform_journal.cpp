@@ -0,0 +1,96 @@
+//
+// Created by taylor-santos on 10/17/2026 at 00:52.
+//
+
+#include "transform_journal.h"
+
+#include <stdexcept>
+
+template<typename T>
+BasicTransformJournal<T>::~BasicTransformJournal() {
+    for (auto &entry : entries_) {
+        if (entry.transform) {
+            entry.transform->journal_ = nullptr;
+        }
+    }
+}
+
+template<typename T>
+void
+BasicTransformJournal<T>::track(Transform &transform, Id id) {
+    if (transform.journal_) {
+        throw std::invalid_argument("Transform is already tracked by a TransformJournal");
+    }
+    std::uint32_t slot;
+    if (freeEntries_.empty()) {
+        slot = static_cast<std::uint32_t>(entries_.size());
+        entries_.emplace_back();
+    } else {
+        slot = freeEntries_.back();
+        freeEntries_.pop_back();
+    }
+    entries_[slot]         = {&transform, id, 0, 0};
+    transform.journal_     = this;
+    transform.journalSlot_ = slot;
+    record(slot);
+}
+
+template<typename T>
+void
+BasicTransformJournal<T>::untrack(Transform &transform) {
+    if (transform.journal_ != this) {
+        throw std::invalid_argument("Transform is not tracked by this TransformJournal");
+    }
+    // The slot may still be listed in changed_, which flush() skips over once it's been cleared.
+    entries_[transform.journalSlot_] = {nullptr, NONE, 0, 0};
+    freeEntries_.push_back(transform.journalSlot_);
+    transform.journal_ = nullptr;
+}
+
+template<typename T>
+std::size_t
+BasicTransformJournal<T>::size() const {
+    return entries_.size() - freeEntries_.size();
+}
+
+template<typename T>
+std::span<const typename BasicTransformJournal<T>::Id>
+BasicTransformJournal<T>::flush() {
+    ids_.clear();
+    for (auto slot : changed_) {
+        if (!entries_[slot].transform) continue;
+        stack_.push_back(entries_[slot].transform);
+        while (!stack_.empty()) {
+            auto *node = stack_.back();
+            stack_.pop_back();
+            if (node->journal_ == this) {
+                auto &entry = entries_[node->journalSlot_];
+                // This subtree was already expanded from a change higher up, or lower down but
+                // earlier in changed_.
+                if (entry.visited == flushes_) continue;
+                entry.visited = flushes_;
+                if (entry.id != NONE) {
+                    ids_.push_back(entry.id);
+                }
+            }
+            for (auto *child = node->firstChild(); child; child = child->nextSibling()) {
+                stack_.push_back(child);
+            }
+        }
+    }
+    changed_.clear();
+    flushes_++;
+    return ids_;
+}
+
+template<typename T>
+void
+BasicTransformJournal<T>::record(std::uint32_t slot) {
+    auto &entry = entries_[slot];
+    if (entry.recorded == flushes_) return;
+    entry.recorded = flushes_;
+    changed_.push_back(slot);
+}
+
+template class BasicTransformJournal<float>;
+template class BasicTransformJournal<double>;
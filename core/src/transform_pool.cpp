@@ -0,0 +1,265 @@
+//
+// Created by taylor-santos on 10/16/2026 at 23:41.
+//
+
+#include "transform_pool.h"
+
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+template<typename T>
+BasicTransformPool<T>::Handle::Handle(std::uint32_t index, std::uint32_t generation)
+    : index_{index}
+    , generation_{generation} {}
+
+template<typename T>
+BasicTransformPool<T>::~BasicTransformPool() {
+    clear();
+}
+
+template<typename T>
+BasicTransformPool<T>::BasicTransformPool(BasicTransformPool &&other) noexcept
+    : chunks_{std::move(other.chunks_)}
+    , generations_{std::move(other.generations_)}
+    , freeSlots_{std::move(other.freeSlots_)}
+    , size_{std::exchange(other.size_, 0)} {}
+
+template<typename T>
+BasicTransformPool<T> &
+BasicTransformPool<T>::operator=(BasicTransformPool &&other) noexcept {
+    if (this != &other) {
+        clear();
+        chunks_      = std::move(other.chunks_);
+        generations_ = std::move(other.generations_);
+        freeSlots_   = std::move(other.freeSlots_);
+        size_        = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+template<typename T>
+typename BasicTransformPool<T>::Handle
+BasicTransformPool<T>::create(const typename Transform::Builder &builder) {
+    if (freeSlots_.empty()) {
+        auto first = static_cast<std::uint32_t>(capacity());
+        // Default-initialize, so that the storage isn't needlessly zeroed before use.
+        chunks_.push_back(Chunk{new Slot[CHUNK_SIZE]});
+        if (generations_.size() < capacity()) {
+            generations_.resize(capacity(), 0);
+        }
+        for (auto i = static_cast<std::uint32_t>(capacity()); i-- > first;) {
+            freeSlots_.push_back(i);
+        }
+    }
+    auto  index = freeSlots_.back();
+    auto &slot  = chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+    // Constructing straight from build() elides the move, which would have to relink the new
+    // Transform into its parent's list of children.
+    new (slot.storage) Transform(builder.build());
+    freeSlots_.pop_back();
+    size_++;
+    return {index, ++generations_[index]};
+}
+
+template<typename T>
+void
+BasicTransformPool<T>::destroy(Handle handle) {
+    if (!contains(handle)) {
+        throw std::out_of_range("Handle does not refer to a Transform in this TransformPool");
+    }
+    release(handle.index_);
+}
+
+template<typename T>
+void
+BasicTransformPool<T>::destroySubtree(Handle handle) {
+    if (!contains(handle)) {
+        throw std::out_of_range("Handle does not refer to a Transform in this TransformPool");
+    }
+    auto ranges = chunkRanges();
+    // Gather the subtree with every parent before its children.
+    std::vector<std::uint32_t> indices{handle.index_};
+    std::vector<Transform *>   outsiders;
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        for (auto *child = node(indices[i])->firstChild(); child; child = child->nextSibling()) {
+            if (auto index = indexOf(child, ranges)) {
+                indices.push_back(*index);
+            } else if (!child->frozen()) {
+                outsiders.push_back(child);
+            }
+        }
+    }
+    // Outsiders must be detached while their ancestors are still alive to say where they are.
+    // Frozen ones can't be, but are left to their parents' destructors, which detach them in
+    // place all the same.
+    for (auto *outsider : outsiders) {
+        outsider->setParent(nullptr);
+    }
+    // Children first, so that every Transform is childless by the time it is destroyed.
+    for (auto it = indices.rbegin(); it != indices.rend(); ++it) {
+        release(*it);
+    }
+}
+
+template<typename T>
+typename BasicTransformPool<T>::Transform &
+BasicTransformPool<T>::get(Handle handle) {
+    if (auto *transform = find(handle)) return *transform;
+    throw std::out_of_range("Handle does not refer to a Transform in this TransformPool");
+}
+
+template<typename T>
+const typename BasicTransformPool<T>::Transform &
+BasicTransformPool<T>::get(Handle handle) const {
+    if (auto *transform = find(handle)) return *transform;
+    throw std::out_of_range("Handle does not refer to a Transform in this TransformPool");
+}
+
+template<typename T>
+typename BasicTransformPool<T>::Transform *
+BasicTransformPool<T>::find(Handle handle) {
+    return contains(handle) ? node(handle.index_) : nullptr;
+}
+
+template<typename T>
+const typename BasicTransformPool<T>::Transform *
+BasicTransformPool<T>::find(Handle handle) const {
+    return contains(handle) ? node(handle.index_) : nullptr;
+}
+
+template<typename T>
+bool
+BasicTransformPool<T>::contains(Handle handle) const {
+    // Only occupied slots have odd generations, so this also rejects destroyed Transforms and
+    // default-constructed Handles.
+    return handle.index_ < capacity() && generations_[handle.index_] == handle.generation_ &&
+           occupied(handle.index_);
+}
+
+template<typename T>
+std::size_t
+BasicTransformPool<T>::size() const {
+    return size_;
+}
+
+template<typename T>
+std::size_t
+BasicTransformPool<T>::capacity() const {
+    return chunks_.size() * CHUNK_SIZE;
+}
+
+template<typename T>
+void
+BasicTransformPool<T>::compact() {
+    auto chunkIsEmpty = [&](std::size_t chunk) {
+        auto first = static_cast<std::uint32_t>(chunk * CHUNK_SIZE);
+        for (auto i = first; i < first + CHUNK_SIZE; i++) {
+            if (occupied(i)) return false;
+        }
+        return true;
+    };
+    while (!chunks_.empty() && chunkIsEmpty(chunks_.size() - 1)) {
+        chunks_.pop_back();
+    }
+    auto end = static_cast<std::uint32_t>(capacity());
+    std::erase_if(freeSlots_, [&](std::uint32_t index) { return index >= end; });
+    std::sort(freeSlots_.begin(), freeSlots_.end(), std::greater<>{});
+}
+
+template<typename T>
+typename BasicTransformPool<T>::Transform *
+BasicTransformPool<T>::node(std::uint32_t index) const {
+    auto &slot = chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+    return std::launder(reinterpret_cast<Transform *>(slot.storage));
+}
+
+template<typename T>
+bool
+BasicTransformPool<T>::occupied(std::uint32_t index) const {
+    return generations_[index] % 2 == 1;
+}
+
+template<typename T>
+std::optional<std::uint32_t>
+BasicTransformPool<T>::indexOf(const Transform *transform, std::span<const ChunkRange> ranges)
+    const {
+    // Pointers into different chunks can only be ordered with std::less.
+    std::less<const void *> less;
+
+    auto after = std::upper_bound(
+        ranges.begin(),
+        ranges.end(),
+        static_cast<const void *>(transform),
+        [&](const void *address, const ChunkRange &range) { return less(address, range.first); });
+    if (after == ranges.begin()) return std::nullopt;
+    auto &range = *std::prev(after);
+    if (!less(transform, range.first + CHUNK_SIZE)) return std::nullopt;
+    auto offset = static_cast<std::uint32_t>(
+        reinterpret_cast<const std::byte *>(transform) -
+        reinterpret_cast<const std::byte *>(range.first));
+    return range.index + offset / static_cast<std::uint32_t>(sizeof(Slot));
+}
+
+template<typename T>
+std::vector<typename BasicTransformPool<T>::ChunkRange>
+BasicTransformPool<T>::chunkRanges() const {
+    std::vector<ChunkRange> ranges;
+    for (std::size_t i = 0; i < chunks_.size(); i++) {
+        ranges.push_back({chunks_[i].get(), static_cast<std::uint32_t>(i * CHUNK_SIZE)});
+    }
+    std::sort(ranges.begin(), ranges.end(), [](const ChunkRange &a, const ChunkRange &b) {
+        return std::less<const Slot *>{}(a.first, b.first);
+    });
+    return ranges;
+}
+
+template<typename T>
+void
+BasicTransformPool<T>::release(std::uint32_t index) {
+    node(index)->~Transform();
+    generations_[index]++;
+    freeSlots_.push_back(index);
+    size_--;
+}
+
+template<typename T>
+void
+BasicTransformPool<T>::clear() {
+    auto end    = static_cast<std::uint32_t>(capacity());
+    auto ranges = chunkRanges();
+    // Outsiders must be detached while their ancestors are still intact to say where they are,
+    // before any pooled Transform is stripped of its parent below.
+    std::vector<Transform *> outsiders;
+    for (std::uint32_t i = 0; i < end; i++) {
+        if (!occupied(i)) continue;
+        for (auto *child = node(i)->firstChild(); child; child = child->nextSibling()) {
+            if (!indexOf(child, ranges) && !child->frozen()) outsiders.push_back(child);
+        }
+    }
+    for (auto *outsider : outsiders) {
+        outsider->setParent(nullptr);
+    }
+    // Then detach every Transform from its parent, keeping local space so that nothing has to be
+    // recomputed. Otherwise each parent's destructor would carefully preserve the world-space
+    // properties of children that are about to be destroyed anyway. Frozen Transforms can't be
+    // detached, so they are left to the destructors, along with any frozen outsiders. Only other
+    // frozen Transforms can be their ancestors, so those are still intact at that point.
+    for (std::uint32_t i = 0; i < end; i++) {
+        if (occupied(i) && !node(i)->frozen()) node(i)->setParent(nullptr, true);
+    }
+    for (std::uint32_t i = 0; i < end; i++) {
+        if (occupied(i)) {
+            node(i)->~Transform();
+            generations_[i]++;
+        }
+    }
+    chunks_.clear();
+    freeSlots_.clear();
+    size_ = 0;
+}
+
+template class BasicTransformPool<float>;
+template class BasicTransformPool<double>;
@@ -0,0 +1,51 @@
+//
+// Created by taylor-santos on 10/17/2026 at 03:05.
+//
+
+#include "transform_snapshot.h"
+
+template<typename T>
+void
+BasicTransformSnapshots<T>::publish(std::span<const Transform *const> transforms) {
+    auto &matrices = buffers_[back_].matrices;
+    matrices.resize(transforms.size());
+    for (std::size_t i = 0; i < transforms.size(); i++) {
+        matrices[i] = transforms[i]->localToWorldMatrix();
+    }
+    swapBack();
+}
+
+template<typename T>
+void
+BasicTransformSnapshots<T>::publish(const Transform &root) {
+    root.updateWorldMatrices();
+    nodes_.clear();
+    nodes_.push_back(&root);
+    for (std::size_t i = 0; i < nodes_.size(); i++) {
+        for (auto *child = nodes_[i]->firstChild(); child; child = child->nextSibling()) {
+            nodes_.push_back(child);
+        }
+    }
+    publish(nodes_);
+}
+
+template<typename T>
+const typename BasicTransformSnapshots<T>::Snapshot &
+BasicTransformSnapshots<T>::acquire() {
+    if (shared_.load(std::memory_order_relaxed) & FRESH) {
+        // Acquire the writer's matrices, and release our old buffer for it to reuse.
+        front_ = shared_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+    }
+    return buffers_[front_];
+}
+
+template<typename T>
+void
+BasicTransformSnapshots<T>::swapBack() {
+    buffers_[back_].sequence = ++published_;
+    // Release our matrices to the reader, and acquire the buffer it last gave up.
+    back_ = shared_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX;
+}
+
+template class BasicTransformSnapshots<float>;
+template class BasicTransformSnapshots<double>;
@@ -10,7 +10,10 @@
 
 #include "glfw.h"
 #include "camera.h"
+#include "fixed_timestep.h"
 #include "transform.h"
+#include "transform_interpolation.h"
+#include "transform_pool.h"
 
 // [Win32] Our example includes a copy of glfw3.lib pre-compiled with VS2010 to maximize ease of
 // testing and compatibility with old VS compilers. To link with VS2010-era libraries, VS2015+
@@ -29,7 +32,11 @@
 
 #include "shader.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <span>
+#include <vector>
 
 #include "plugin.h"
 
@@ -147,8 +154,8 @@ main(int argc, char **argv) {
         "layout(location=0) in vec3 position;" // Vertex position (x, y, z)
         "layout(location=1) in vec3 color;"    // Vertex color (r, g, b)
         "out vec3 fColor;"                     // Vertex shader has to pass color to fragment shader
+        "layout(location=2) in mat4 obj;"      // Per-instance world matrix, in locations 2-5
         "uniform mat4 MVP;"
-        "uniform mat4 obj;"
         "void main()"
         "{"
         "    fColor = color;"                            // Pass color to fragment shader
@@ -329,6 +336,22 @@ main(int argc, char **argv) {
         6 * sizeof(GLfloat),
         (void *)(3 * sizeof(GLfloat)));
 
+    // Each instance's world matrix is read from its own buffer, one column per attribute.
+    GLuint instanceVbo;
+    glGenBuffers(1, &instanceVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    for (GLuint column = 0; column < 4; column++) {
+        glEnableVertexAttribArray(2 + column);
+        glVertexAttribPointer(
+            2 + column,
+            4,
+            GL_FLOAT,
+            GL_FALSE,
+            16 * sizeof(GLfloat),
+            (void *)(column * 4 * sizeof(GLfloat)));
+        glVertexAttribDivisor(2 + column, 1);
+    }
+
     glBindVertexArray(0);
 
     glEnable(GL_DEPTH_TEST);
@@ -343,12 +366,52 @@ main(int argc, char **argv) {
     ImVec4                 clear_color         = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
     double                 lastTime            = glfwGetTime();
     double                 deltaTime           = 0;
-    std::vector<Transform> transforms;
-    transforms.emplace_back();
-    transforms.emplace_back(Transform::Builder().withParent(transforms[0]).withPosition({2, 0, 0}));
-    transforms.emplace_back(Transform::Builder().withParent(transforms[1]));
-    transforms.emplace_back(Transform::Builder().withParent(transforms[1]).withPosition({2, 0, 0}));
-    transforms.emplace_back(Transform::Builder().withParent(transforms[1]).withPosition({4, 0, 0}));
+    // These cubes are only ever rendered, so single precision is enough and their matrices can be
+    // uploaded without conversion. The pool keeps each cube at a fixed address, so adding more
+    // never has to relink the hierarchy.
+    TransformPoolF cubes;
+    auto           addCube = [&](TransformPoolF::Handle parent, glm::vec3 position) {
+        return cubes.create(
+            TransformF::Builder().withParent(cubes.get(parent)).withPosition(position));
+    };
+    auto base   = cubes.create();
+    auto arm    = addCube(base, {2, 0, 0});
+    auto hand   = addCube(arm, {0, 0, 0});
+    auto thumb  = addCube(arm, {2, 0, 0});
+    auto finger = addCube(arm, {4, 0, 0});
+    TransformPoolF::Handle cubeHandles[] = {base, arm, hand, thumb, finger};
+    std::vector<const TransformF *> cubeTransforms;
+    for (auto handle : cubeHandles) {
+        cubeTransforms.push_back(&cubes.get(handle));
+    }
+    // The cubes are simulated at a fixed rate, independent of the frame rate, and drawn between
+    // their last two simulated states. Interpolated matrices change every frame, so they are all
+    // exported and uploaded every frame, staged in glm::mat4s to keep each one 16-byte aligned.
+    FixedTimestep           simulation(1.0 / 30);
+    TransformInterpolationF cubeStates;
+    cubeStates.capture(cubeTransforms);
+    std::vector<glm::mat4> cubeInterpolated(cubeTransforms.size());
+    // Only the cubes whose bounding spheres intersect the camera's frustum are uploaded and drawn.
+    // The spheres are kept as a structure of arrays, as Frustum::cull() expects.
+    std::vector<float>         cubeX(cubeTransforms.size());
+    std::vector<float>         cubeY(cubeTransforms.size());
+    std::vector<float>         cubeZ(cubeTransforms.size());
+    std::vector<float>         cubeRadius(cubeTransforms.size());
+    std::vector<std::uint32_t> cubeVisible(cubeTransforms.size());
+    std::vector<glm::mat4>     cubeCulled(cubeTransforms.size());
+    std::vector<glm::mat4>     cubeMatrices(cubeTransforms.size());
+    auto cubeFloats = std::span(glm::value_ptr(cubeMatrices[0]), 16 * cubeMatrices.size());
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        static_cast<GLsizeiptr>(cubeFloats.size_bytes()),
+        nullptr,
+        GL_DYNAMIC_DRAW);
+    // Everything is rendered relative to an origin near the camera, so that precision doesn't fall
+    // off far from the world origin. It only follows the camera once the camera strays far from
+    // it, so that the view matrix's origin stays put between most frames.
+    constexpr double renderRadius = 1024;
+    glm::dvec3       renderOrigin = camera.transform.position();
 
     glfwSwapInterval(0);
     // Main loop
@@ -361,22 +424,29 @@ main(int argc, char **argv) {
             update(nullptr);
         }
 
-        deltaTime = glfwGetTime() - lastTime;
-        lastTime  = glfwGetTime();
+        auto now  = glfwGetTime();
+        deltaTime = now - lastTime;
+        lastTime  = now;
 
+        // The camera follows input every frame, so that it stays responsive at any frame rate.
         auto pos     = camera.transform.position();
         auto forward = camera.forward();
         auto right   = camera.right();
         pos += static_cast<float>(deltaTime) * (velocity.x * right + velocity.y * forward);
         camera.transform.setLocalPosition(pos);
 
-        transforms[0].setLocalRotation(glm::angleAxis(lastTime, glm::dvec3{0, 0, 1}));
-        transforms[0].setLocalSkew({glm::cos(lastTime), 0, 0});
-        transforms[1].setLocalRotation(glm::angleAxis(lastTime, glm::dvec3{0, 1, 0}));
-        transforms[1].setLocalScale({1, 1, 0.5});
-        transforms[2].setPosition({1, 1, 1});
-        transforms[3].setScale({1, 1, 1});
-        transforms[4].setSkew({0, 0, 0});
+        auto steps = simulation.advance(deltaTime);
+        for (auto step = simulation.steps() - steps + 1; step <= simulation.steps(); step++) {
+            auto time = static_cast<float>(static_cast<double>(step) * simulation.step());
+            cubes.get(base).setLocalRotation(glm::angleAxis(time, glm::vec3{0, 0, 1}));
+            cubes.get(base).setLocalSkew({glm::cos(time), 0, 0});
+            cubes.get(arm).setLocalRotation(glm::angleAxis(time, glm::vec3{0, 1, 0}));
+            cubes.get(arm).setLocalScale({1, 1, 0.5});
+            cubes.get(hand).setPosition({1, 1, 1});
+            cubes.get(thumb).setScale({1, 1, 1});
+            cubes.get(finger).setSkew({0, 0, 0});
+            cubeStates.capture(cubeTransforms);
+        }
 
         // Poll and handle events (inputs, window resize, etc.)
         // You can read the io.WantCaptureMouse, io.WantCaptureKeyboard flags to tell if
@@ -456,18 +526,52 @@ main(int argc, char **argv) {
 
         auto [display_w, display_h] = window.getFrameBufferSize();
 
-        glm::mat4 mvp   = camera.getMatrix((float)display_w / (float)display_h);
+        if (glm::distance(camera.transform.position(), renderOrigin) > renderRadius) {
+            renderOrigin = camera.transform.position();
+        }
+        camera.setAspect((float)display_w / (float)display_h);
+        camera.setOrigin(renderOrigin);
+        glm::mat4 mvp   = camera.matrices().viewProjection;
         GLint     mvpID = program.getUniformLocation("MVP");
         glUniformMatrix4fv(mvpID, 1, GL_FALSE, glm::value_ptr(mvp));
-        GLint objID = program.getUniformLocation("obj");
-        for (auto &transform : transforms) {
-            glm::mat4 obj = transform.localToWorldMatrix();
-            glUniformMatrix4fv(objID, 1, GL_FALSE, glm::value_ptr(obj));
-
-            glBindVertexArray(vao);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-            glDrawElements(GL_TRIANGLES, sizeof(indices), GL_UNSIGNED_SHORT, nullptr);
+        cubeStates.interpolate(static_cast<float>(simulation.alpha()), cubeInterpolated);
+        for (std::size_t i = 0; i < cubeInterpolated.size(); i++) {
+            auto &mat    = cubeInterpolated[i];
+            auto  center = glm::dvec3(mat[3]) - renderOrigin;
+            cubeX[i]     = static_cast<float>(center.x);
+            cubeY[i]     = static_cast<float>(center.y);
+            cubeZ[i]     = static_cast<float>(center.z);
+            // Every corner of the unit cube is within half the summed lengths of its axes.
+            cubeRadius[i] = 0.5f * (glm::length(glm::vec3(mat[0])) +
+                                    glm::length(glm::vec3(mat[1])) +
+                                    glm::length(glm::vec3(mat[2])));
+        }
+        auto visibleCubes =
+            camera.frustum().cull(Frustum::Spheres{cubeX, cubeY, cubeZ, cubeRadius}, cubeVisible);
+        for (std::size_t i = 0; i < visibleCubes; i++) {
+            cubeCulled[i] = cubeInterpolated[cubeVisible[i]];
+        }
+        if (visibleCubes > 0) {
+            auto floats = cubeFloats.first(16 * visibleCubes);
+            TransformF::exportMatrices(
+                std::span(cubeCulled).first(visibleCubes),
+                floats,
+                glm::vec3(renderOrigin));
+            glBindBuffer(GL_ARRAY_BUFFER, instanceVbo);
+            glBufferSubData(
+                GL_ARRAY_BUFFER,
+                0,
+                static_cast<GLsizeiptr>(floats.size_bytes()),
+                floats.data());
         }
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+        glDrawElementsInstanced(
+            GL_TRIANGLES,
+            static_cast<GLsizei>(std::size(indices)),
+            GL_UNSIGNED_SHORT,
+            nullptr,
+            static_cast<GLsizei>(visibleCubes));
 
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         window.updatePlatformWindows();
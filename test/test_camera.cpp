@@ -67,6 +67,116 @@ TEST_CASE("CameraProjection") {
     }
 }
 
+TEST_CASE("CameraRelativeMatrix") {
+    // Far from the world origin, a camera-relative view must match an identical camera at the
+    // world origin looking at the same offsets.
+    Camera farCamera;
+    Camera nearCamera;
+    farCamera.transform.setLocalPosition({1e8 + 3.25, -2e8 - 5.5, 3e8 + 13.75});
+    for (auto *camera : {&farCamera, &nearCamera}) {
+        camera->setNear(1.0f);
+        camera->setFar(10.0f);
+        camera->setRotation(30, -20);
+    }
+    auto relative = farCamera.getMatrix(1.0f, farCamera.transform.position());
+    auto expected = nearCamera.getMatrix(1.0f);
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            CHECK(relative[col][row] == doctest::Approx(expected[col][row]));
+        }
+    }
+
+    // Without an origin, the far camera's position is off by more than the whole view frustum.
+    glm::vec3 offset = glm::dvec3(glm::vec3(farCamera.transform.position())) -
+                       farCamera.transform.position();
+    CHECK(glm::length(offset) > 10.0f);
+}
+
+TEST_CASE("CameraCachedMatrices") {
+    Transform parent;
+    Camera    camera;
+    camera.transform.setParent(&parent);
+    camera.setAspect(2.0f);
+    camera.setNear(0.1f);
+    camera.setFar(100.0f);
+    auto checkInverses = [](const Camera::Matrices &m) {
+        auto identity = glm::mat4(1);
+        for (auto product :
+             {m.view * m.inverseView,
+              m.projection * m.inverseProjection,
+              m.viewProjection * m.inverseViewProjection}) {
+            for (int col = 0; col < 4; col++) {
+                for (int row = 0; row < 4; row++) {
+                    CHECK(product[col][row] == doctest::Approx(identity[col][row]).epsilon(1e-4));
+                }
+            }
+        }
+    };
+
+    const auto &matrices = camera.matrices();
+    checkInverses(matrices);
+    auto before = matrices.viewProjection;
+    CHECK(camera.matrices().viewProjection == before);
+
+    // Moving an ancestor moves the camera, so the view must be rebuilt.
+    parent.setLocalPosition({0, 0, 5});
+    CHECK(camera.matrices().viewProjection != before);
+    glm::vec4 eye = camera.matrices().inverseView * glm::vec4{0, 0, 0, 1};
+    CHECK(eye.z == doctest::Approx(5));
+
+    auto projection = camera.matrices().projection;
+    camera.setFOV(60);
+    CHECK(camera.matrices().projection != projection);
+    projection = camera.matrices().projection;
+    camera.setAspect(1.0f);
+    CHECK(camera.matrices().projection != projection);
+    checkInverses(camera.matrices());
+
+    auto view = camera.matrices().view;
+    camera.setRotation(45, 10);
+    CHECK(camera.matrices().view != view);
+    checkInverses(camera.matrices());
+}
+
+TEST_CASE("CameraGetMatrixIsConst") {
+    Camera camera;
+    camera.transform.setLocalPosition({1, 2, 3});
+    camera.setAspect(2.0f);
+    camera.setOrigin({1, 2, 3});
+    const auto &matrices = camera.matrices();
+    auto        before   = matrices.viewProjection;
+
+    // Reading another aspect ratio or origin leaves the camera's own settings and matrices alone.
+    auto other = camera.getMatrix(1.0f);
+    CHECK(camera.getAspect() == 2.0f);
+    CHECK(camera.getOrigin() == glm::dvec3(1, 2, 3));
+    CHECK(camera.matrices().viewProjection == before);
+    CHECK(other != before);
+    CHECK(camera.getMatrix(2.0f, {1, 2, 3}) == before);
+
+    Camera reference;
+    reference.transform.setLocalPosition({1, 2, 3});
+    auto expected = reference.matrices().viewProjection;
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            CHECK(other[col][row] == doctest::Approx(expected[col][row]));
+        }
+    }
+}
+
+TEST_CASE("CameraSwappedTransform") {
+    // Both Transforms have been changed equally often, so their generations are likely to match.
+    Camera    camera;
+    Transform other;
+    camera.transform.setLocalPosition({0, 0, 1});
+    other.setLocalPosition({0, 0, 5});
+    auto before = camera.matrices().view;
+    camera.transform.swap(other);
+    CHECK(camera.matrices().view != before);
+    glm::vec4 eye = camera.matrices().inverseView * glm::vec4{0, 0, 0, 1};
+    CHECK(eye.z == doctest::Approx(5));
+}
+
 TEST_CASE("CameraSensitivity") {
     Camera cam;
     SUBCASE("TwoArgs") {
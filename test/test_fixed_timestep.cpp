@@ -0,0 +1,39 @@
+//
+// Created by taylor-santos on 10/17/2026 at 10:40.
+//
+
+#include "fixed_timestep.h"
+#include "doctest/doctest.h"
+
+#include <stdexcept>
+
+TEST_SUITE_BEGIN("FixedTimestep");
+
+TEST_CASE("Accumulates") {
+    FixedTimestep timestep(0.25);
+    CHECK(timestep.advance(0.1) == 0);
+    CHECK(timestep.alpha() == doctest::Approx(0.4));
+    CHECK(timestep.advance(0.2) == 1);
+    CHECK(timestep.alpha() == doctest::Approx(0.2));
+    CHECK(timestep.advance(0.5) == 2);
+    CHECK(timestep.alpha() == doctest::Approx(0.2));
+    CHECK(timestep.steps() == 3);
+    CHECK(timestep.time() == doctest::Approx(0.75));
+    CHECK(timestep.advance(-1) == 0);
+    CHECK(timestep.alpha() == doctest::Approx(0.2));
+}
+
+TEST_CASE("DropsTimeBeyondMaxSteps") {
+    FixedTimestep timestep(0.1, 4);
+    // A long stall, such as a breakpoint, must not make the simulation try to catch up.
+    CHECK(timestep.advance(10.05) == 4);
+    CHECK(timestep.alpha() == doctest::Approx(0.5));
+    CHECK(timestep.steps() == 4);
+    CHECK(timestep.advance(0.05) == 1);
+}
+
+TEST_CASE("InvalidArguments") {
+    CHECK_THROWS_AS(FixedTimestep(0), std::invalid_argument);
+    CHECK_THROWS_AS(FixedTimestep(-1), std::invalid_argument);
+    CHECK_THROWS_AS(FixedTimestep(1, 0), std::invalid_argument);
+}
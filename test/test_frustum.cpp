@@ -0,0 +1,102 @@
+//
+// Created by taylor-santos on 10/17/2026 at 11:55.
+//
+
+#include "camera.h"
+#include "frustum.h"
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "glm/gtc/random.hpp"
+
+TEST_SUITE_BEGIN("Frustum");
+
+TEST_CASE("Planes") {
+    // The default camera sits at the origin and looks down the negative z axis.
+    Camera camera;
+    camera.setNear(1.0f);
+    camera.setFar(10.0f);
+    camera.setFOV(90);
+    auto frustum = camera.frustum();
+    auto nearPlane = frustum.plane(Frustum::Side::NEAR_CLIP);
+    auto farPlane  = frustum.plane(Frustum::Side::FAR_CLIP);
+    CHECK(nearPlane.z == doctest::Approx(-1));
+    CHECK(nearPlane.w == doctest::Approx(-1));
+    CHECK(farPlane.z == doctest::Approx(1));
+    CHECK(farPlane.w == doctest::Approx(10));
+
+    CHECK(frustum.intersectsSphere({0, 0, -5}, 0.5f));
+    CHECK(frustum.intersectsSphere({0, 0, 0}, 1.5f));
+    CHECK_FALSE(frustum.intersectsSphere({0, 0, 5}, 1));
+    CHECK_FALSE(frustum.intersectsSphere({0, 0, -12}, 1));
+    // At a depth of 5, the 90 degree field of view reaches 5 units to either side.
+    CHECK(frustum.intersectsSphere({5.5f, 0, -5}, 1));
+    CHECK_FALSE(frustum.intersectsSphere({8, 0, -5}, 1));
+    CHECK(frustum.containsSphere({0, 0, -5}, 0.5f));
+    CHECK_FALSE(frustum.containsSphere({0, 0, -5}, 4));
+    CHECK_FALSE(frustum.containsSphere({5.5f, 0, -5}, 1));
+
+    CHECK(frustum.intersectsBox({0, 0, -5}, {1, 1, 1}));
+    CHECK(frustum.intersectsBox({0, 0, 1}, {1, 1, 2.5f}));
+    CHECK_FALSE(frustum.intersectsBox({0, 0, 2}, {1, 1, 1}));
+    CHECK_FALSE(frustum.intersectsBox({0, 9, -5}, {1, 1, 1}));
+}
+
+TEST_CASE("BatchCull") {
+    Camera camera;
+    camera.transform.setLocalPosition({3, -1, 2});
+    camera.setRotation(40, -15);
+    camera.setNear(0.5f);
+    camera.setFar(50.0f);
+    auto frustum = camera.frustum();
+
+    // Enough bounds to fill several groups of SIMD lanes, with a partial group left at the end.
+    constexpr std::size_t COUNT = 203;
+    std::vector<float>    x, y, z, radius, ex, ey, ez;
+    for (std::size_t i = 0; i < COUNT; i++) {
+        auto center = glm::ballRand(40.0f);
+        x.push_back(center.x);
+        y.push_back(center.y);
+        z.push_back(center.z);
+        radius.push_back(glm::linearRand(0.1f, 5.0f));
+        auto extent = glm::linearRand(glm::vec3(0.1f), glm::vec3(5.0f));
+        ex.push_back(extent.x);
+        ey.push_back(extent.y);
+        ez.push_back(extent.z);
+    }
+    std::vector<std::uint32_t> visible(COUNT);
+
+    auto count = frustum.cull(Frustum::Spheres{x, y, z, radius}, visible);
+    std::vector<std::uint32_t> expected;
+    for (std::uint32_t i = 0; i < COUNT; i++) {
+        if (frustum.intersectsSphere({x[i], y[i], z[i]}, radius[i])) expected.push_back(i);
+    }
+    REQUIRE(count == expected.size());
+    CHECK(std::vector(visible.begin(), visible.begin() + count) == expected);
+    CHECK(count > 0);
+    CHECK(count < COUNT);
+
+    count = frustum.cull(Frustum::Boxes{x, y, z, ex, ey, ez}, visible);
+    expected.clear();
+    for (std::uint32_t i = 0; i < COUNT; i++) {
+        if (frustum.intersectsBox({x[i], y[i], z[i]}, {ex[i], ey[i], ez[i]})) {
+            expected.push_back(i);
+        }
+    }
+    REQUIRE(count == expected.size());
+    CHECK(std::vector(visible.begin(), visible.begin() + count) == expected);
+
+    std::vector<std::uint32_t> tooSmall(COUNT - 1);
+    CHECK_THROWS_AS(
+        (void)frustum.cull(Frustum::Spheres{x, y, z, radius}, tooSmall),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        (void)frustum.cull(Frustum::Spheres{x, y, z, std::span(radius).first(3)}, visible),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        (void)frustum.cull(Frustum::Boxes{x, y, z, ex, ey, std::span(ez).first(3)}, visible),
+        std::invalid_argument);
+}
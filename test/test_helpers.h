@@ -0,0 +1,47 @@
+//
+// Created by taylor-santos on 10/17/2026 at 17:20.
+//
+
+#pragma once
+
+#include "doctest/doctest.h"
+
+#include "glm/gtc/epsilon.hpp"
+
+// Assertions shared by the Transform tests, comparing scalars, vectors, and matrices of either
+// precision component by component, to within the same tolerance.
+
+#define CHECK_EPS_EQ(a, b)                          \
+    do {                                            \
+        CHECK(glm::epsilonEqual((a), (b), 0.0001)); \
+    } while (0)
+
+#define CHECK_VEC3_EQ(a, b)           \
+    do {                              \
+        CHECK_EPS_EQ((a)[0], (b)[0]); \
+        CHECK_EPS_EQ((a)[1], (b)[1]); \
+        CHECK_EPS_EQ((a)[2], (b)[2]); \
+    } while (0)
+
+#define CHECK_VEC4_EQ(a, b)           \
+    do {                              \
+        CHECK_EPS_EQ((a)[0], (b)[0]); \
+        CHECK_EPS_EQ((a)[1], (b)[1]); \
+        CHECK_EPS_EQ((a)[2], (b)[2]); \
+        CHECK_EPS_EQ((a)[3], (b)[3]); \
+    } while (0)
+
+#define CHECK_MAT3_EQ(a, b)            \
+    do {                               \
+        CHECK_VEC3_EQ((a)[0], (b)[0]); \
+        CHECK_VEC3_EQ((a)[1], (b)[1]); \
+        CHECK_VEC3_EQ((a)[2], (b)[2]); \
+    } while (0)
+
+#define CHECK_MAT4_EQ(a, b)            \
+    do {                               \
+        CHECK_VEC4_EQ((a)[0], (b)[0]); \
+        CHECK_VEC4_EQ((a)[1], (b)[1]); \
+        CHECK_VEC4_EQ((a)[2], (b)[2]); \
+        CHECK_VEC4_EQ((a)[3], (b)[3]); \
+    } while (0)
@@ -0,0 +1,169 @@
+//
+// Created by taylor-santos on 10/17/2026 at 14:55.
+//
+
+#include "camera.h"
+#include "occlusion_buffer.h"
+#include "doctest/doctest.h"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/random.hpp"
+
+TEST_SUITE_BEGIN("OcclusionBuffer");
+
+namespace {
+
+// A square in the plane z = depth, facing the default camera, as two triangles.
+struct Quad {
+    std::array<glm::vec3, 4>     vertices;
+    std::array<std::uint32_t, 6> indices{0, 1, 2, 0, 2, 3};
+};
+
+Quad
+wall(float halfSize, float depth) {
+    return {{{
+        {-halfSize, -halfSize, depth},
+        {halfSize, -halfSize, depth},
+        {halfSize, halfSize, depth},
+        {-halfSize, halfSize, depth},
+    }}};
+}
+
+} // namespace
+
+TEST_CASE("Rasterize") {
+    // The default camera sits at the origin and looks down the negative z axis, with a 90 degree
+    // field of view, so a wall 10 units away and 10 units across fills the middle of the screen.
+    Camera          camera;
+    auto            viewProjection = camera.getMatrix(1.0f);
+    OcclusionBuffer buffer(64, 64);
+    buffer.clear(viewProjection);
+    auto quad = wall(5, -10);
+    buffer.rasterize(quad.vertices, quad.indices);
+
+    auto clip     = viewProjection * glm::vec4(0, 0, -10, 1);
+    auto expected = (clip.z / clip.w + 1) * 0.5f;
+    CHECK(buffer.depth(32, 32) == doctest::Approx(expected));
+    CHECK(buffer.depth(17, 46) == doctest::Approx(expected));
+    CHECK(buffer.depth(15, 32) == 1);
+    CHECK(buffer.depth(0, 0) == 1);
+    CHECK_THROWS_AS((void)buffer.depth(64, 0), std::out_of_range);
+
+    CHECK_THROWS_AS((void)buffer.occludesBox({0, 0, -20}, {1, 1, 1}), std::logic_error);
+    buffer.buildHierarchy();
+    CHECK(buffer.occludesBox({0, 0, -20}, {1, 1, 1}));
+    CHECK(buffer.occludesSphere({0, 0, -30}, 2));
+    // In front of the wall.
+    CHECK_FALSE(buffer.occludesBox({0, 0, -5}, {1, 1, 1}));
+    // Reaching out past the wall's edges.
+    CHECK_FALSE(buffer.occludesBox({0, 0, -20}, {15, 1, 1}));
+    // Off-screen, and around the camera.
+    CHECK_FALSE(buffer.occludesBox({100, 0, -20}, {1, 1, 1}));
+    CHECK_FALSE(buffer.occludesBox({0, 0, 0}, {1, 1, 1}));
+
+    // Seen from behind, the wall still occludes.
+    auto flipped    = quad;
+    flipped.indices = {0, 2, 1, 0, 3, 2};
+    buffer.clear(viewProjection);
+    buffer.rasterize(flipped.vertices, flipped.indices);
+    buffer.buildHierarchy();
+    CHECK(buffer.occludesBox({0, 0, -20}, {1, 1, 1}));
+
+    // Occluders are placed by their model matrix, here moving the wall to fill the screen.
+    buffer.clear(viewProjection);
+    buffer.rasterize(quad.vertices, quad.indices, glm::translate(glm::mat4(1), glm::vec3(0, 0, 5)));
+    buffer.buildHierarchy();
+    CHECK(buffer.occludesBox({0, 0, -8}, {1, 1, 1}));
+    CHECK_FALSE(buffer.occludesBox({0, 0, -3}, {1, 1, 1}));
+}
+
+TEST_CASE("BeyondFarPlane") {
+    Camera camera;
+    camera.setFar(50);
+    OcclusionBuffer buffer(64, 64);
+    buffer.clear(camera.getMatrix(1.0f));
+    // A wall filling the screen, with boxes behind it on either side of the far plane.
+    auto quad = wall(20, -10);
+    buffer.rasterize(quad.vertices, quad.indices);
+    buffer.buildHierarchy();
+    CHECK(buffer.occludesBox({0, 0, -40}, {1, 1, 1}));
+    CHECK_FALSE(buffer.occludesBox({0, 0, -60}, {1, 1, 1}));
+    CHECK_FALSE(buffer.occludesSphere({0, 0, -60}, 1));
+}
+
+TEST_CASE("NearPlaneClipping") {
+    Camera          camera;
+    OcclusionBuffer buffer(64, 64);
+    buffer.clear(camera.getMatrix(1.0f));
+    // A floor passing beneath the camera, from behind it to far in front.
+    std::array<glm::vec3, 4> floor{{{-5, -1, 5}, {5, -1, 5}, {5, -1, -50}, {-5, -1, -50}}};
+    std::array<std::uint32_t, 6> indices{0, 1, 2, 0, 2, 3};
+    buffer.rasterize(floor, indices);
+    buffer.buildHierarchy();
+    CHECK(buffer.depth(32, 0) < 1);
+    CHECK(buffer.depth(32, 20) < 1);
+    CHECK(buffer.depth(32, 40) == 1);
+    // Beneath the floor, and above it.
+    CHECK(buffer.occludesBox({0, -3, -20}, {0.5f, 0.5f, 0.5f}));
+    CHECK_FALSE(buffer.occludesBox({0, 1, -20}, {0.5f, 0.5f, 0.5f}));
+}
+
+TEST_CASE("BatchOcclusionCull") {
+    Camera camera;
+    camera.transform.setLocalPosition({1, 2, 3});
+    camera.setRotation(20, -10);
+    // Odd dimensions, so that rows are padded and the hierarchy has odd-sized levels.
+    OcclusionBuffer buffer(50, 31);
+    buffer.clear(camera.getMatrix(50.0f / 31.0f, glm::dvec3(1, 2, 3)));
+    auto quad = wall(4, 0);
+    for (int i = 0; i < 10; i++) {
+        auto model = glm::translate(glm::mat4(1), glm::ballRand(15.0f));
+        buffer.rasterize(quad.vertices, quad.indices, model);
+    }
+    buffer.buildHierarchy();
+
+    constexpr std::size_t COUNT = 300;
+    std::vector<float>    x, y, z, ex, ey, ez;
+    for (std::size_t i = 0; i < COUNT; i++) {
+        auto center = glm::ballRand(30.0f);
+        auto extent = glm::linearRand(glm::vec3(0.1f), glm::vec3(2.0f));
+        x.push_back(center.x);
+        y.push_back(center.y);
+        z.push_back(center.z);
+        ex.push_back(extent.x);
+        ey.push_back(extent.y);
+        ez.push_back(extent.z);
+    }
+    Frustum::Boxes             boxes{x, y, z, ex, ey, ez};
+    std::vector<std::uint32_t> visible(COUNT);
+    for (std::uint32_t i = 0; i < COUNT; i++) visible[i] = i;
+    auto count = buffer.cull(boxes, visible);
+
+    std::vector<std::uint32_t> expected;
+    for (std::uint32_t i = 0; i < COUNT; i++) {
+        if (!buffer.occludesBox({x[i], y[i], z[i]}, {ex[i], ey[i], ez[i]})) expected.push_back(i);
+    }
+    REQUIRE(count == expected.size());
+    CHECK(std::vector(visible.begin(), visible.begin() + count) == expected);
+
+    std::vector<std::uint32_t> outOfRange{0, COUNT};
+    CHECK_THROWS_AS((void)buffer.cull(boxes, outOfRange), std::invalid_argument);
+    CHECK_THROWS_AS(
+        (void)buffer.cull(Frustum::Boxes{x, y, z, ex, ey, std::span(ez).first(3)}, visible),
+        std::invalid_argument);
+}
+
+TEST_CASE("OcclusionInvalidArguments") {
+    CHECK_THROWS_AS((void)OcclusionBuffer(0, 10), std::invalid_argument);
+    OcclusionBuffer              buffer(8, 8);
+    std::array<glm::vec3, 3>     vertices{};
+    std::array<std::uint32_t, 2> partial{0, 1};
+    std::array<std::uint32_t, 3> outOfRange{0, 1, 3};
+    CHECK_THROWS_AS(buffer.rasterize(vertices, partial), std::invalid_argument);
+    CHECK_THROWS_AS(buffer.rasterize(vertices, outOfRange), std::invalid_argument);
+}
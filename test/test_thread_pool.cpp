@@ -0,0 +1,67 @@
+//
+// Created by taylor-santos on 10/16/2026 at 23:02.
+//
+
+#include "thread_pool.h"
+#include "doctest/doctest.h"
+
+#include <atomic>
+#include <stdexcept>
+
+TEST_SUITE_BEGIN("ThreadPool");
+
+TEST_CASE("RunsEveryTask") {
+    ThreadPool            pool(4);
+    std::atomic<int>      count{0};
+    ThreadPool::TaskGroup group(pool);
+    for (int i = 0; i < 1000; i++) {
+        group.run([&] { count++; });
+    }
+    group.wait();
+    CHECK(count == 1000);
+}
+
+TEST_CASE("NestedTasks") {
+    ThreadPool            pool(4);
+    std::atomic<int>      count{0};
+    ThreadPool::TaskGroup group(pool);
+    for (int i = 0; i < 10; i++) {
+        group.run([&] {
+            for (int j = 0; j < 10; j++) {
+                group.run([&] { count++; });
+            }
+        });
+    }
+    group.wait();
+    CHECK(count == 100);
+}
+
+TEST_CASE("NoWorkers") {
+    ThreadPool pool(0);
+    CHECK(pool.size() == 0);
+    int                   count = 0;
+    ThreadPool::TaskGroup group(pool);
+    for (int i = 0; i < 10; i++) {
+        group.run([&] { count++; });
+    }
+    // Nothing runs until the group is waited on.
+    CHECK(count == 0);
+    group.wait();
+    CHECK(count == 10);
+}
+
+TEST_CASE("TaskException") {
+    ThreadPool            pool(2);
+    std::atomic<int>      count{0};
+    ThreadPool::TaskGroup group(pool);
+    for (int i = 0; i < 10; i++) {
+        group.run([&, i] {
+            count++;
+            if (i == 5) throw std::runtime_error("task failed");
+        });
+    }
+    CHECK_THROWS_AS(group.wait(), std::runtime_error);
+    CHECK(count == 10);
+    // The exception is only reported once.
+    CHECK_NOTHROW(group.wait());
+}
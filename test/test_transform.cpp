@@ -3,8 +3,16 @@
 //
 
 #include "transform.h"
+#include "camera.h"
+#include "frustum.h"
+#include "thread_pool.h"
+#include "test_helpers.h"
 #include "doctest/doctest.h"
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include "glm/gtc/random.hpp"
 
 TEST_SUITE_BEGIN("Transform");
@@ -12,41 +20,6 @@ DOCTEST_CLANG_SUPPRESS_WARNING_PUSH
 DOCTEST_CLANG_SUPPRESS_WARNING("-Wunused-parameter")
 DOCTEST_CLANG_SUPPRESS_WARNING("-Wunused-variable")
 
-#define CHECK_EPS_EQ(a, b)                          \
-    do {                                            \
-        CHECK(glm::epsilonEqual((a), (b), 0.0001)); \
-    } while (0)
-
-#define CHECK_VEC3_EQ(a, b)           \
-    do {                              \
-        CHECK_EPS_EQ((a)[0], (b)[0]); \
-        CHECK_EPS_EQ((a)[1], (b)[1]); \
-        CHECK_EPS_EQ((a)[2], (b)[2]); \
-    } while (0)
-
-#define CHECK_VEC4_EQ(a, b)           \
-    do {                              \
-        CHECK_EPS_EQ((a)[0], (b)[0]); \
-        CHECK_EPS_EQ((a)[1], (b)[1]); \
-        CHECK_EPS_EQ((a)[2], (b)[2]); \
-        CHECK_EPS_EQ((a)[3], (b)[3]); \
-    } while (0)
-
-#define CHECK_MAT3_EQ(a, b)            \
-    do {                               \
-        CHECK_VEC3_EQ((a)[0], (b)[0]); \
-        CHECK_VEC3_EQ((a)[1], (b)[1]); \
-        CHECK_VEC3_EQ((a)[2], (b)[2]); \
-    } while (0)
-
-#define CHECK_MAT4_EQ(a, b)            \
-    do {                               \
-        CHECK_VEC4_EQ((a)[0], (b)[0]); \
-        CHECK_VEC4_EQ((a)[1], (b)[1]); \
-        CHECK_VEC4_EQ((a)[2], (b)[2]); \
-        CHECK_VEC4_EQ((a)[3], (b)[3]); \
-    } while (0)
-
 DOCTEST_MSVC_SUPPRESS_WARNING_WITH_PUSH(4505) // unreferenced local function has been removed
 DOCTEST_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wunused-function")
 DOCTEST_CLANG_SUPPRESS_WARNING_WITH_PUSH("-Wunused-function")
@@ -309,6 +282,96 @@ TEST_CASE("SetWorldProps") {
     }
 }
 
+TEST_CASE("SetWorldPropsFastPaths") {
+    // Roots and children of a parent with uniform scale and no skew skip decomposition entirely.
+    auto rot = glm::angleAxis(glm::linearRand(0.0, 2 * glm::pi<double>()), glm::sphericalRand(1.0));
+
+    Transform parent =
+        Transform::Builder().withPosition({1, 2, 3}).withRotation(rot).withScale(glm::dvec3(2.5));
+    Transform similar = randomTransform(&parent);
+    Transform root    = randomTransform();
+    for (auto child : {&similar, &root}) {
+        auto worldProps = Transform::decompose(child->localToWorldMatrix());
+        auto newRot =
+            glm::angleAxis(glm::linearRand(0.0, 2 * glm::pi<double>()), glm::sphericalRand(1.0));
+        child->setRotation(newRot);
+        CHECK_MAT3_EQ(glm::toMat3(child->rotation()), glm::toMat3(newRot));
+        CHECK_VEC3_EQ(child->position(), worldProps.translation);
+        CHECK_VEC3_EQ(child->scale(), worldProps.scale);
+        CHECK_VEC3_EQ(child->skew(), worldProps.skew);
+
+        auto scale = glm::linearRand(glm::dvec3(0.01), glm::dvec3(10.0));
+        child->setScale(scale);
+        CHECK_MAT3_EQ(glm::toMat3(child->rotation()), glm::toMat3(newRot));
+        CHECK_VEC3_EQ(child->position(), worldProps.translation);
+        CHECK_VEC3_EQ(child->scale(), scale);
+        CHECK_VEC3_EQ(child->skew(), worldProps.skew);
+
+        auto skew = glm::linearRand(glm::dvec3(-0.5), glm::dvec3(0.5));
+        child->setSkew(skew);
+        CHECK_MAT3_EQ(glm::toMat3(child->rotation()), glm::toMat3(newRot));
+        CHECK_VEC3_EQ(child->position(), worldProps.translation);
+        CHECK_VEC3_EQ(child->scale(), scale);
+        CHECK_VEC3_EQ(child->skew(), skew);
+
+        auto pos = glm::linearRand(glm::dvec3{-10, -10, -10}, glm::dvec3{10, 10, 10});
+        child->setPosition(pos);
+        CHECK_VEC3_EQ(child->position(), pos);
+        CHECK_VEC3_EQ(child->scale(), scale);
+        // The cached world matrix must agree with one rebuilt from the new local properties.
+        auto parentMat = child->parent() ? parent.localToWorldMatrix() : glm::dmat4{1};
+        CHECK_MAT4_EQ(child->localToWorldMatrix(), parentMat * child->localToParentMatrix());
+    }
+}
+
+TEST_CASE("RigidComposition") {
+    // Beneath similarities, world properties are composed rather than decomposed, and must agree
+    // with decomposing the world matrix.
+    std::vector<Transform> chain;
+    chain.reserve(5);
+    for (int i = 0; i < 4; i++) {
+        auto pos = glm::linearRand(glm::dvec3{-10, -10, -10}, glm::dvec3{10, 10, 10});
+        auto rot =
+            glm::angleAxis(glm::linearRand(0.0, 2 * glm::pi<double>()), glm::sphericalRand(1.0));
+        auto builder = Transform::Builder().withPosition(pos).withRotation(rot).withScale(
+            glm::dvec3(glm::linearRand(0.5, 2.0)));
+        if (!chain.empty()) builder.withParent(chain.back());
+        chain.push_back(builder);
+    }
+    chain.push_back(randomTransform(&chain.back()));
+    auto &leaf = chain.back();
+
+    auto checkAgainstDecompose = [&]() {
+        for (auto &node : chain) {
+            auto expected = Transform::decompose(node.localToWorldMatrix());
+            CHECK_VEC3_EQ(node.position(), expected.translation);
+            CHECK_MAT3_EQ(glm::toMat3(node.rotation()), glm::toMat3(expected.rotation));
+            CHECK_VEC3_EQ(node.scale(), expected.scale);
+            CHECK_VEC3_EQ(node.skew(), expected.skew);
+        }
+    };
+    checkAgainstDecompose();
+
+    SUBCASE("Reparent") {
+        auto      world = leaf.localToWorldMatrix();
+        Transform other = Transform::Builder().withPosition({1, 2, 3}).withScale(glm::dvec3(3));
+        leaf.setParent(&other);
+        CHECK_MAT4_EQ(leaf.localToWorldMatrix(), world);
+        Transform::Edit().setParent(leaf, &chain[1]).commit();
+        CHECK_MAT4_EQ(leaf.localToWorldMatrix(), world);
+        leaf.setParent(&chain[3]);
+        checkAgainstDecompose();
+    }
+    SUBCASE("FallBack") {
+        // Skew anywhere up the chain must send every descendant back to decomposing.
+        chain[1].setLocalSkew({0.25, 0, 0});
+        checkAgainstDecompose();
+        chain[2].setLocalScale({1, 2, 3});
+        chain[1].setLocalSkew({0, 0, 0});
+        checkAgainstDecompose();
+    }
+}
+
 TEST_CASE("Directions") {
     auto parent = randomTransform();
     auto child  = randomTransform(&parent);
@@ -341,3 +404,550 @@ TEST_CASE("DestructorRemovesChildren") {
     CHECK(child.parent() == nullptr);
     CHECK_MAT4_EQ(child.localToWorldMatrix(), mat);
 }
+
+TEST_CASE("SiblingLinks") {
+    Transform a, b, c, d;
+    {
+        Transform parent;
+        for (auto t : {&a, &b, &c, &d}) {
+            t->setParent(&parent);
+        }
+        // Swap adjacent and non-adjacent siblings, then unlink one from the middle.
+        b = std::move(c);
+        a = std::move(d);
+        c.setParent(nullptr);
+        CHECK(a.parent() == &parent);
+        CHECK(b.parent() == &parent);
+        CHECK(c.parent() == nullptr);
+        CHECK(d.parent() == &parent);
+    }
+    // The parent's destructor must have reached every remaining child.
+    CHECK(a.parent() == nullptr);
+    CHECK(b.parent() == nullptr);
+    CHECK(d.parent() == nullptr);
+}
+
+TEST_CASE("AffineInverse") {
+    auto root       = randomTransform();
+    auto child      = randomTransform(&root);
+    auto grandChild = randomTransform(&child);
+    for (auto *t : {&root, &child, &grandChild}) {
+        CHECK_MAT4_EQ(Transform::affineInverse(t->localToParentMatrix()), t->parentToLocalMatrix());
+        CHECK_MAT4_EQ(
+            Transform::affineInverse(t->localToWorldMatrix()) * t->localToWorldMatrix(),
+            glm::dmat4(1));
+    }
+    CHECK_MAT4_EQ(
+        grandChild.worldToLocalMatrix(),
+        grandChild.parentToLocalMatrix() * child.parentToLocalMatrix() *
+            root.parentToLocalMatrix());
+}
+
+TEST_CASE("BatchDecompose") {
+    // Enough matrices to fill several groups of SIMD lanes, with a partial group left at the end.
+    constexpr std::size_t   COUNT = 37;
+    std::vector<glm::dmat4> mats;
+    for (std::size_t i = 0; i < COUNT; i++) {
+        mats.push_back(randomTransform().localToParentMatrix());
+    }
+    // Flip a column to make a reflection, which must be folded into the x scale.
+    mats[5][0] = -mats[5][0];
+    std::vector<Transform::Properties> props(COUNT);
+    Transform::decompose(mats, props);
+    for (std::size_t i = 0; i < COUNT; i++) {
+        auto expected = Transform::decompose(mats[i]);
+        CHECK_VEC3_EQ(props[i].translation, expected.translation);
+        CHECK_MAT3_EQ(glm::toMat3(props[i].rotation), glm::toMat3(expected.rotation));
+        // Both paths must return the same unit quaternion, not just the same rotation.
+        CHECK(glm::length(expected.rotation) == doctest::Approx(1).epsilon(1e-12));
+        for (int c = 0; c < 4; c++) {
+            CHECK(props[i].rotation[c] == doctest::Approx(expected.rotation[c]).epsilon(1e-12));
+        }
+        CHECK_VEC3_EQ(props[i].scale, expected.scale);
+        CHECK_VEC3_EQ(props[i].skew, expected.skew);
+    }
+    std::vector<Transform::Properties> wrongSize(COUNT - 1);
+    CHECK_THROWS_AS(Transform::decompose(mats, wrongSize), std::invalid_argument);
+}
+
+TEST_CASE("BatchRecompose") {
+    constexpr std::size_t              COUNT = 37;
+    std::vector<Transform::Properties> props;
+    for (std::size_t i = 0; i < COUNT; i++) {
+        props.push_back(Transform::decompose(randomTransform().localToParentMatrix()));
+    }
+    std::vector<glm::dmat4> mats(COUNT);
+    Transform::recompose(props, mats);
+    for (std::size_t i = 0; i < COUNT; i++) {
+        CHECK_MAT4_EQ(mats[i], Transform::recompose(props[i]));
+    }
+    std::vector<glm::dmat4> wrongSize(COUNT + 1);
+    CHECK_THROWS_AS(Transform::recompose(props, wrongSize), std::invalid_argument);
+}
+
+TEST_CASE("BatchTransformPoints") {
+    constexpr std::size_t   COUNT  = 37;
+    Transform               parent = randomTransform();
+    Transform               child  = randomTransform(&parent);
+    std::vector<glm::dvec3> points;
+    for (std::size_t i = 0; i < COUNT; i++) {
+        points.push_back(glm::linearRand(glm::dvec3(-10), glm::dvec3(10)));
+    }
+    auto toWorld = child.localToWorldMatrix();
+    auto toLocal = child.worldToLocalMatrix();
+
+    std::vector<glm::dvec3> out(COUNT);
+    child.transformPoints(points, out);
+    for (std::size_t i = 0; i < COUNT; i++) {
+        CHECK_VEC3_EQ(out[i], glm::dvec3(toWorld * glm::dvec4(points[i], 1)));
+    }
+    child.transformDirections(points, out);
+    for (std::size_t i = 0; i < COUNT; i++) {
+        CHECK_VEC3_EQ(out[i], glm::dvec3(toWorld * glm::dvec4(points[i], 0)));
+    }
+    child.inverseTransformPoints(points, out);
+    for (std::size_t i = 0; i < COUNT; i++) {
+        CHECK_VEC3_EQ(out[i], glm::dvec3(toLocal * glm::dvec4(points[i], 1)));
+    }
+
+    // Transforming in place and back again must round-trip.
+    auto original = points;
+    child.transformPoints(points, points);
+    child.inverseTransformPoints(points, points);
+    for (std::size_t i = 0; i < COUNT; i++) {
+        CHECK_VEC3_EQ(points[i], original[i]);
+    }
+
+    std::vector<glm::dvec3> wrongSize(COUNT - 1);
+    CHECK_THROWS_AS(child.transformPoints(points, wrongSize), std::invalid_argument);
+
+    TransformF single = TransformF::Builder().withPosition({1, 2, 3}).withScale({2, 2, 2});
+    std::vector<glm::vec3> singlePoints(COUNT, glm::vec3{1, 0, 0});
+    single.transformPoints(singlePoints, singlePoints);
+    for (auto &point : singlePoints) {
+        CHECK(point == glm::vec3{3, 2, 3});
+    }
+}
+
+TEST_CASE("ExportMatrices") {
+    constexpr std::size_t          COUNT = 7;
+    std::vector<Transform>         nodes;
+    std::vector<const Transform *> pointers;
+    nodes.reserve(COUNT);
+    nodes.push_back(randomTransform());
+    for (std::size_t i = 1; i < COUNT; i++) {
+        nodes.push_back(randomTransform(&nodes[i - 1]));
+    }
+    std::vector<glm::dmat4> mats;
+    for (auto &node : nodes) {
+        pointers.push_back(&node);
+        mats.push_back(node.localToWorldMatrix());
+    }
+
+    alignas(16) std::array<float, 16 * COUNT> buffer{};
+    Transform::exportWorldMatrices(pointers, buffer);
+    for (std::size_t i = 0; i < COUNT; i++) {
+        auto expected = glm::mat4(mats[i]);
+        for (int j = 0; j < 16; j++) {
+            CHECK(buffer[16 * i + j] == expected[j / 4][j % 4]);
+        }
+    }
+    std::array<float, 16 * COUNT> exported{};
+    std::copy(buffer.begin(), buffer.end(), exported.begin());
+    Transform::exportMatrices(mats, buffer);
+    CHECK(buffer == exported);
+
+    CHECK_THROWS_AS(
+        Transform::exportMatrices(mats, std::span(buffer).first(16 * COUNT - 1)),
+        std::invalid_argument);
+    CHECK_THROWS_AS(
+        Transform::exportMatrices(std::span(mats).first(1), std::span(buffer).subspan(1, 16)),
+        std::invalid_argument);
+
+    TransformF        single    = TransformF::Builder().withPosition({1, 2, 3});
+    const TransformF *singles[] = {&single};
+    Transform::exportMatrices({}, std::span(buffer).first(0));
+    TransformF::exportWorldMatrices(singles, std::span(buffer).first(16));
+    CHECK(buffer[12] == 1);
+    CHECK(buffer[13] == 2);
+    CHECK(buffer[14] == 3);
+}
+
+TEST_CASE("ExportRelativeToOrigin") {
+    // Far enough out that a float can't tell these two apart.
+    glm::dvec3 far{1e8 + 3.25, -2e8 - 5.5, 3e8 + 13.75};
+    Transform  camera = Transform::Builder().withPosition(far);
+    Transform  parent = Transform::Builder().withPosition(far + glm::dvec3{0.25, 0, 0});
+    Transform  child  = Transform::Builder()
+                           .withParent(parent)
+                           .withRotation(glm::angleAxis(1.0, glm::dvec3{0, 1, 0}))
+                           .withPosition({0, 0.5, 0});
+    const Transform *nodes[] = {&parent, &child};
+
+    alignas(16) std::array<float, 32> buffer{};
+    Transform::exportWorldMatrices(nodes, buffer, camera.position());
+    for (std::size_t i = 0; i < 2; i++) {
+        auto expected = nodes[i]->localToWorldMatrix();
+        expected[3] -= glm::dvec4(camera.position(), 0);
+        for (int j = 0; j < 16; j++) {
+            CHECK(buffer[16 * i + j] == static_cast<float>(expected[j / 4][j % 4]));
+        }
+    }
+    CHECK(buffer[12] == 0.25f);
+    CHECK(buffer[29] == 0.5f);
+
+    std::array<float, 32> exported{};
+    std::copy(buffer.begin(), buffer.end(), exported.begin());
+    glm::dmat4 mats[] = {parent.localToWorldMatrix(), child.localToWorldMatrix()};
+    Transform::exportMatrices(mats, buffer, camera.position());
+    CHECK(buffer == exported);
+}
+
+TEST_CASE("SinglePrecision") {
+    CHECK(sizeof(TransformF::Properties) * 2 == sizeof(Transform::Properties));
+    Transform::Properties parentProps{
+        {1, 2, 3},
+        glm::angleAxis(0.5, glm::normalize(glm::dvec3{1, 1, 0})),
+        {2, 1, 0.5},
+        {0.1, 0, 0.2}};
+    Transform::Properties childProps{
+        {-2, 0, 1},
+        glm::angleAxis(1.5, glm::dvec3{0, 0, 1}),
+        {1, 3, 1},
+        {0, -0.3, 0}};
+    auto toFloat = [](const Transform::Properties &props) {
+        return TransformF::Builder()
+            .withPosition(TransformF::Vec3(props.translation))
+            .withRotation(TransformF::Quat(props.rotation))
+            .withScale(TransformF::Vec3(props.scale))
+            .withSkew(TransformF::Vec3(props.skew));
+    };
+    Transform  parent  = Transform::Builder()
+                            .withPosition(parentProps.translation)
+                            .withRotation(parentProps.rotation)
+                            .withScale(parentProps.scale)
+                            .withSkew(parentProps.skew);
+    Transform  child   = Transform::Builder()
+                           .withParent(parent)
+                           .withPosition(childProps.translation)
+                           .withRotation(childProps.rotation)
+                           .withScale(childProps.scale)
+                           .withSkew(childProps.skew);
+    TransformF parentF = toFloat(parentProps);
+    TransformF childF  = toFloat(childProps).withParent(parentF);
+    SUBCASE("Matrices") {
+        CHECK_MAT4_EQ(glm::dmat4(childF.localToWorldMatrix()), child.localToWorldMatrix());
+        CHECK_MAT4_EQ(glm::dmat4(childF.worldToLocalMatrix()), child.worldToLocalMatrix());
+    }
+    SUBCASE("Batch") {
+        std::vector<TransformF::Properties> props(
+            11,
+            TransformF::decompose(childF.localToWorldMatrix()));
+        std::vector<glm::mat4> mats(props.size());
+        TransformF::recompose(props, mats);
+        std::vector<TransformF::Properties> roundTrip(props.size());
+        TransformF::decompose(mats, roundTrip);
+        for (std::size_t i = 0; i < props.size(); i++) {
+            CHECK_MAT4_EQ(glm::dmat4(mats[i]), child.localToWorldMatrix());
+            CHECK_VEC3_EQ(glm::dvec3(roundTrip[i].scale), glm::dvec3(props[i].scale));
+            CHECK_VEC3_EQ(glm::dvec3(roundTrip[i].skew), glm::dvec3(props[i].skew));
+        }
+    }
+    SUBCASE("WorldSetters") {
+        childF.setPosition({4, 5, 6});
+        child.setPosition({4, 5, 6});
+        CHECK_VEC3_EQ(glm::dvec3(childF.position()), child.position());
+        CHECK_VEC3_EQ(glm::dvec3(childF.localPosition()), child.localPosition());
+    }
+}
+
+TEST_CASE("LazyInvalidation") {
+    auto root       = randomTransform();
+    auto child      = randomTransform(&root);
+    auto grandChild = randomTransform(&child);
+
+    auto expected = [&]() {
+        return root.localToParentMatrix() * child.localToParentMatrix() *
+               grandChild.localToParentMatrix();
+    };
+    // Populate every cache in the chain.
+    CHECK_MAT4_EQ(grandChild.localToWorldMatrix(), expected());
+    CHECK_VEC3_EQ(grandChild.position(), glm::dvec3(expected()[3]));
+
+    SUBCASE("RootChange") {
+        root.setLocalRotation(glm::angleAxis(1.0, glm::dvec3{0, 1, 0}));
+        CHECK_MAT4_EQ(grandChild.localToWorldMatrix(), expected());
+        CHECK_VEC3_EQ(grandChild.position(), glm::dvec3(expected()[3]));
+    }
+    SUBCASE("RepeatedChangesWithoutReads") {
+        for (int i = 0; i < 10; i++) {
+            root.setLocalPosition({i, 0, 0});
+            child.setLocalScale({1, 1 + i, 1});
+        }
+        CHECK_MAT4_EQ(grandChild.worldToLocalMatrix() * expected(), glm::dmat4(1));
+        CHECK_MAT4_EQ(grandChild.localToWorldMatrix(), expected());
+    }
+    SUBCASE("IntermediateRead") {
+        root.setLocalPosition({1, 2, 3});
+        // Reading the middle of the chain revalidates it, but the leaf must still notice.
+        CHECK_MAT4_EQ(
+            child.localToWorldMatrix(),
+            root.localToParentMatrix() * child.localToParentMatrix());
+        CHECK_MAT4_EQ(grandChild.localToWorldMatrix(), expected());
+    }
+    SUBCASE("WorldSetterOnAncestor") {
+        child.setPosition({4, 5, 6});
+        CHECK_VEC3_EQ(child.position(), glm::dvec3(4, 5, 6));
+        CHECK_MAT4_EQ(grandChild.localToWorldMatrix(), expected());
+    }
+}
+
+TEST_CASE("ParallelUpdate") {
+    constexpr std::size_t count = 2000;
+    // Children hold pointers to their parents, so neither vector may reallocate.
+    std::vector<Transform> serial, parallel;
+    serial.reserve(count);
+    parallel.reserve(count);
+    auto copyOf = [](const Transform &t, Transform *parent) {
+        auto builder = Transform::Builder()
+                           .withPosition(t.localPosition())
+                           .withRotation(t.localRotation())
+                           .withScale(t.localScale())
+                           .withSkew(t.localSkew());
+        if (parent) {
+            builder = builder.withParent(*parent);
+        }
+        return builder.build();
+    };
+    serial.push_back(randomTransform());
+    parallel.push_back(copyOf(serial.back(), nullptr));
+    for (std::size_t i = 1; i < count; i++) {
+        // Bias towards recent nodes so that the trees are deep as well as wide.
+        auto span   = static_cast<double>(i - 1 - i / 2);
+        auto parent = i / 2 + static_cast<std::size_t>(glm::linearRand(0.0, span));
+        serial.push_back(randomTransform(&serial[parent]));
+        parallel.push_back(copyOf(serial.back(), &parallel[parent]));
+    }
+
+    ThreadPool pool(4);
+    serial.front().updateWorldMatrices();
+    parallel.front().updateWorldMatrices(pool);
+    for (std::size_t i = 0; i < count; i++) {
+        CHECK(serial[i].localToWorldMatrix() == parallel[i].localToWorldMatrix());
+    }
+
+    // Only the changed subtrees should need recomputing, and they must still match exactly.
+    for (std::size_t i = 0; i < count; i += 97) {
+        auto pos = glm::dvec3{static_cast<double>(i), 1, 2};
+        serial[i].setLocalPosition(pos);
+        parallel[i].setLocalPosition(pos);
+    }
+    serial.front().updateWorldMatrices();
+    parallel.front().updateWorldMatrices(pool);
+    for (std::size_t i = 0; i < count; i++) {
+        CHECK(serial[i].localToWorldMatrix() == parallel[i].localToWorldMatrix());
+        auto expected = serial[i].parent()
+                            ? serial[i].parent()->localToWorldMatrix() *
+                                  serial[i].localToParentMatrix()
+                            : serial[i].localToParentMatrix();
+        CHECK_MAT4_EQ(serial[i].localToWorldMatrix(), expected);
+    }
+}
+
+TEST_CASE("SubtreeBounds") {
+    auto root  = randomTransform();
+    auto child = randomTransform(&root);
+    auto leaf  = randomTransform(&child);
+    CHECK_FALSE(root.subtreeBounds().has_value());
+
+    leaf.setLocalBounds(Transform::Sphere{{1, 2, 3}, 0.5});
+    child.setLocalBounds(Transform::Sphere{{0, 0, 0}, 2});
+    CHECK(leaf.localBounds()->radius == 0.5);
+    auto encloses = [](const Transform::Sphere &outer, const Transform &node) {
+        // Every point on the surface of the node's local sphere must lie inside outer.
+        auto local = *node.localBounds();
+        for (int i = 0; i < 100; i++) {
+            auto point = glm::dvec3(
+                node.localToWorldMatrix() *
+                glm::dvec4(local.center + glm::sphericalRand(local.radius), 1));
+            if (glm::distance(point, outer.center) > outer.radius + 0.0001) return false;
+        }
+        return true;
+    };
+    auto bounds = root.subtreeBounds();
+    REQUIRE(bounds.has_value());
+    CHECK(encloses(*bounds, leaf));
+    CHECK(encloses(*bounds, child));
+    CHECK(encloses(*child.subtreeBounds(), leaf));
+
+    SUBCASE("DescendantChange") {
+        leaf.setLocalPosition({100, 0, 0});
+        CHECK(encloses(*root.subtreeBounds(), leaf));
+    }
+    SUBCASE("AncestorChange") {
+        root.setLocalScale({3, 1, 0.5});
+        CHECK(encloses(*child.subtreeBounds(), leaf));
+        CHECK(encloses(*root.subtreeBounds(), leaf));
+    }
+    SUBCASE("Reparent") {
+        auto other = randomTransform();
+        leaf.setParent(&other);
+        CHECK(encloses(*other.subtreeBounds(), leaf));
+        child.setLocalBounds(std::nullopt);
+        CHECK_FALSE(root.subtreeBounds().has_value());
+    }
+    SUBCASE("Copy") {
+        Transform copy = leaf;
+        REQUIRE(copy.localBounds().has_value());
+        CHECK(copy.localBounds()->radius == 0.5);
+        auto other = randomTransform();
+        other      = leaf;
+        REQUIRE(other.localBounds().has_value());
+        CHECK(other.localBounds()->radius == 0.5);
+        // Both copies are children of leaf's parent, so its subtree now holds them too.
+        CHECK(encloses(*child.subtreeBounds(), copy));
+        CHECK(encloses(*child.subtreeBounds(), other));
+    }
+    SUBCASE("NegativeRadius") {
+        auto inverted = Transform::Sphere{{0, 0, 0}, -1};
+        CHECK_THROWS_AS(leaf.setLocalBounds(inverted), std::invalid_argument);
+    }
+}
+
+TEST_CASE("HierarchicalCull") {
+    // The default camera sits at the origin and looks down the negative z axis.
+    Camera camera;
+    camera.setNear(0.1f);
+    camera.setFar(100.0f);
+    camera.setFOV(90);
+    auto frustum = camera.frustum();
+
+    constexpr std::size_t rooms = 20, perRoom = 50;
+    // Children hold pointers to their parents, so the vector may not reallocate.
+    std::vector<Transform> nodes;
+    nodes.reserve(1 + rooms * (perRoom + 1));
+    auto &root = nodes.emplace_back();
+    for (std::size_t r = 0; r < rooms; r++) {
+        // Rooms are rigid and uniformly scaled, so that their contents' world radii are exact.
+        auto &room =
+            nodes.emplace_back(Transform::Builder()
+                                   .withParent(root)
+                                   .withPosition(glm::linearRand(glm::dvec3(-80), glm::dvec3(80)))
+                                   .withRotation(glm::angleAxis(
+                                       glm::linearRand(0.0, 2 * glm::pi<double>()),
+                                       glm::sphericalRand(1.0)))
+                                   .withScale(glm::dvec3(glm::linearRand(0.5, 2.0))));
+        for (std::size_t i = 0; i < perRoom; i++) {
+            auto &object = nodes.emplace_back(
+                Transform::Builder()
+                    .withParent(room)
+                    .withPosition(glm::linearRand(glm::dvec3(-5), glm::dvec3(5))));
+            object.setLocalBounds(Transform::Sphere{{0, 0, 0}, 0.5});
+        }
+    }
+
+    auto check = [&]() {
+        std::vector<const Transform *> visible;
+        root.cull(frustum, visible);
+        std::sort(visible.begin(), visible.end());
+        std::vector<const Transform *> expected;
+        for (auto &node : nodes) {
+            if (!node.localBounds()) continue;
+            auto center = glm::vec3(node.position());
+            auto radius = static_cast<float>(0.5 * node.scale().x);
+            if (frustum.intersectsSphere(center, radius)) expected.push_back(&node);
+        }
+        std::sort(expected.begin(), expected.end());
+        CHECK(visible == expected);
+        return visible.size();
+    };
+    check();
+
+    SUBCASE("MovedRoom") {
+        // Move every room in front of the camera, then one of them behind it.
+        for (std::size_t r = 0; r < rooms; r++) {
+            nodes[1 + r * (perRoom + 1)].setLocalPosition({0, 0, -50});
+        }
+        CHECK(check() == rooms * perRoom);
+        nodes[1].setLocalPosition({0, 0, 20});
+        CHECK(check() == (rooms - 1) * perRoom);
+    }
+    SUBCASE("RemovedBounds") {
+        for (auto &node : nodes) {
+            node.setLocalBounds(std::nullopt);
+        }
+        CHECK(check() == 0);
+    }
+}
+
+TEST_CASE("SubtreeBoundsDeepHierarchy") {
+    // Deep enough that computing the bounds recursively would overflow the stack.
+    constexpr std::size_t depth = 100000;
+    std::vector<Transform> chain;
+    chain.reserve(depth);
+    chain.emplace_back();
+    for (std::size_t i = 1; i < depth; i++) {
+        chain.emplace_back(
+            Transform::Builder().withParent(chain.back()).withPosition({0, 0, -0.0001}));
+    }
+    chain.back().setLocalBounds(Transform::Sphere{{0, 0, 0}, 1});
+    auto bounds = chain.front().subtreeBounds();
+    REQUIRE(bounds.has_value());
+    CHECK_VEC3_EQ(bounds->center, glm::dvec3(0, 0, -0.0001 * (depth - 1)));
+    CHECK(bounds->radius == doctest::Approx(1));
+
+    Camera camera;
+    std::vector<const Transform *> visible;
+    chain.front().cull(camera.frustum(), visible);
+    CHECK(visible == std::vector<const Transform *>{&chain.back()});
+}
+
+TEST_CASE("Edit") {
+    auto a = randomTransform();
+    auto b = randomTransform();
+    auto c = randomTransform(&a);
+    auto d = randomTransform(&c);
+
+    SUBCASE("PreservesWorldSpace") {
+        auto worldB = b.localToWorldMatrix();
+        auto worldC = c.localToWorldMatrix();
+        auto worldD = d.localToWorldMatrix();
+        // b moves beneath d while d moves beneath b's old sibling, so each new parent is itself
+        // being moved by the same edit.
+        Transform::Edit().setParent(b, &d).setParent(d, &a).setParent(c, &b).commit();
+        CHECK(b.parent() == &d);
+        CHECK(c.parent() == &b);
+        CHECK(d.parent() == &a);
+        CHECK_MAT4_EQ(b.localToWorldMatrix(), worldB);
+        CHECK_MAT4_EQ(c.localToWorldMatrix(), worldC);
+        CHECK_MAT4_EQ(d.localToWorldMatrix(), worldD);
+    }
+    SUBCASE("PreservesLocalSpace") {
+        auto localC = c.localToParentMatrix();
+        Transform::Edit().setParent(c, &b, true).commit();
+        CHECK(c.parent() == &b);
+        CHECK_MAT4_EQ(c.localToParentMatrix(), localC);
+        CHECK_MAT4_EQ(
+            d.localToWorldMatrix(),
+            b.localToWorldMatrix() * localC * d.localToParentMatrix());
+    }
+    SUBCASE("LastChangeWins") {
+        Transform::Edit edit;
+        edit.setParent(d, &b).setParent(d, nullptr).commit();
+        CHECK(d.parent() == nullptr);
+        // Committing clears the edit.
+        edit.commit();
+        CHECK(d.parent() == nullptr);
+    }
+    SUBCASE("Cycle") {
+        auto            localA = a.localToParentMatrix();
+        Transform::Edit edit;
+        // Neither change alone makes a cycle, but together they do.
+        edit.setParent(b, &d).setParent(a, &b);
+        CHECK_THROWS_AS(edit.commit(), std::invalid_argument);
+        CHECK(a.parent() == nullptr);
+        CHECK(b.parent() == nullptr);
+        CHECK(a.localToParentMatrix() == localA);
+        CHECK_THROWS_AS(Transform::Edit().setParent(a, &a).commit(), std::invalid_argument);
+    }
+}
@@ -0,0 +1,153 @@
+//
+// Created by taylor-santos on 10/17/2026 at 02:40.
+//
+
+#include "transform_bake.h"
+#include "doctest/doctest.h"
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+TEST_SUITE_BEGIN("TransformBake");
+
+TEST_CASE("Bake") {
+    Transform root  = Transform::Builder().withPosition({1, 0, 0});
+    Transform wall  = Transform::Builder().withParent(root).withScale({2, 2, 2});
+    Transform torch = Transform::Builder().withParent(wall).withPosition({0, 1, 0});
+    Transform other;
+
+    auto baked = root.bake();
+    REQUIRE(baked.size() == 3);
+    CHECK(baked.transforms()[0] == &root);
+    CHECK(baked.transforms()[1] == &wall);
+    CHECK(baked.transforms()[2] == &torch);
+    for (std::size_t i = 0; i < baked.size(); i++) {
+        CHECK(baked.matrices()[i] == baked.transforms()[i]->localToWorldMatrix());
+        CHECK(baked.transforms()[i]->frozen());
+    }
+    CHECK_FALSE(other.frozen());
+    CHECK_THROWS_AS((void)torch.bake(), std::invalid_argument);
+    CHECK_THROWS_AS((void)root.bake(), std::logic_error);
+}
+
+TEST_CASE("FrozenSetters") {
+    Transform root;
+    Transform child = Transform::Builder().withParent(root).withPosition({0, 1, 0});
+    Transform other;
+    auto      baked = root.bake();
+    auto      world = child.localToWorldMatrix();
+
+    CHECK_THROWS_AS(child.setPosition({1, 2, 3}), std::logic_error);
+    CHECK_THROWS_AS(child.setLocalPosition({1, 2, 3}), std::logic_error);
+    CHECK_THROWS_AS(child.setRotation(glm::dquat{0, 1, 0, 0}), std::logic_error);
+    CHECK_THROWS_AS(child.setLocalRotation(glm::dquat{0, 1, 0, 0}), std::logic_error);
+    CHECK_THROWS_AS(child.setScale({2, 2, 2}), std::logic_error);
+    CHECK_THROWS_AS(child.setLocalScale({2, 2, 2}), std::logic_error);
+    CHECK_THROWS_AS(child.setSkew({1, 0, 0}), std::logic_error);
+    CHECK_THROWS_AS(child.setLocalSkew({1, 0, 0}), std::logic_error);
+    CHECK_THROWS_AS(child.setParent(&other), std::logic_error);
+    CHECK_THROWS_AS(child = other, std::logic_error);
+    CHECK_THROWS_AS(Transform::Edit().setParent(child, nullptr).commit(), std::logic_error);
+    CHECK(child.parent() == &root);
+    CHECK(child.localToWorldMatrix() == world);
+
+    // New children of a frozen Transform are not part of the bake.
+    Transform late = Transform::Builder().withParent(child);
+    CHECK_FALSE(late.frozen());
+    late.setLocalPosition({1, 0, 0});
+    CHECK(baked.size() == 2);
+}
+
+TEST_CASE("Unfreeze") {
+    Transform root;
+    Transform child = Transform::Builder().withParent(root);
+
+    SUBCASE("Explicit") {
+        auto baked = root.bake();
+        baked.unfreeze();
+        CHECK(baked.size() == 0);
+        CHECK_FALSE(child.frozen());
+        child.setLocalPosition({1, 0, 0});
+    }
+    SUBCASE("Destroyed") {
+        {
+            auto baked = root.bake();
+        }
+        CHECK_FALSE(root.frozen());
+        root.setLocalPosition({1, 0, 0});
+    }
+    SUBCASE("Moved") {
+        TransformBake moved;
+        {
+            auto baked = root.bake();
+            moved      = std::move(baked);
+        }
+        CHECK(child.frozen());
+        CHECK(moved.size() == 2);
+        moved = TransformBake{};
+        CHECK_FALSE(child.frozen());
+    }
+}
+
+TEST_CASE("DestroyFrozen") {
+    Transform root = Transform::Builder().withPosition({1, 0, 0});
+    auto      wall = std::make_unique<Transform>(
+        Transform::Builder().withParent(root).withScale({2, 2, 2}).build());
+    Transform torch = Transform::Builder().withParent(*wall).withPosition({0, 1, 0});
+    auto      baked = root.bake();
+    REQUIRE(baked.size() == 3);
+    auto world = torch.localToWorldMatrix();
+
+    // The wall leaves the bake, and the torch is detached where it was baked, still frozen.
+    wall.reset();
+    REQUIRE(baked.size() == 2);
+    CHECK(baked.transforms()[0] == &root);
+    CHECK(baked.transforms()[1] == &torch);
+    CHECK(baked.matrices()[1] == world);
+    CHECK(torch.parent() == nullptr);
+    CHECK(torch.frozen());
+    auto detached = torch.localToWorldMatrix();
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            CHECK(detached[col][row] == doctest::Approx(world[col][row]));
+        }
+    }
+
+    // Thawing must not touch the destroyed wall.
+    baked.unfreeze();
+    CHECK_FALSE(torch.frozen());
+}
+
+TEST_CASE("MoveFrozen") {
+    std::vector<Transform> nodes;
+    nodes.reserve(2);
+    nodes.emplace_back(Transform::Builder().withPosition({1, 0, 0}));
+    nodes.emplace_back(Transform::Builder().withParent(nodes[0]).withPosition({0, 1, 0}));
+    auto baked = nodes[0].bake();
+    auto world = nodes[1].localToWorldMatrix();
+
+    // Reallocating moves every Transform, and the bake follows them.
+    nodes.reserve(100);
+    REQUIRE(baked.size() == 2);
+    CHECK(baked.transforms()[0] == &nodes[0]);
+    CHECK(baked.transforms()[1] == &nodes[1]);
+    CHECK(nodes[1].parent() == &nodes[0]);
+    CHECK(nodes[0].frozen());
+    CHECK(nodes[1].frozen());
+    CHECK(baked.matrices()[1] == world);
+    CHECK(nodes[1].localToWorldMatrix() == world);
+
+    // Swapping with a Transform outside the bake hands it the frozen state.
+    Transform other;
+    nodes[1].swap(other);
+    CHECK_FALSE(nodes[1].frozen());
+    CHECK(other.frozen());
+    CHECK(other.parent() == &nodes[0]);
+    CHECK(baked.transforms()[1] == &other);
+
+    nodes.clear();
+    CHECK(baked.size() == 1);
+    CHECK(baked.transforms()[0] == &other);
+}
@@ -0,0 +1,173 @@
+//
+// Created by taylor-santos on 10/16/2026 at 19:52.
+//
+
+#include "transform_hierarchy.h"
+#include "test_helpers.h"
+#include "doctest/doctest.h"
+
+#include <algorithm>
+
+#include "glm/gtc/random.hpp"
+
+TEST_SUITE_BEGIN("TransformHierarchy");
+
+static Transform::Properties
+randomProperties() {
+    auto pos = glm::linearRand(glm::dvec3{-10, -10, -10}, glm::dvec3{10, 10, 10});
+    auto rot = glm::angleAxis(glm::linearRand(0.0, 2 * glm::pi<double>()), glm::sphericalRand(1.0));
+    auto scale = glm::linearRand(glm::dvec3(0.5), glm::dvec3(2.0));
+    auto skew  = glm::linearRand(glm::dvec3(-0.5), glm::dvec3(0.5));
+    return {pos, rot, scale, skew};
+}
+
+TEST_CASE("MatchesTransform") {
+    // Build the same random tree out of both Transforms and hierarchy nodes.
+    constexpr int                         COUNT = 200;
+    TransformHierarchy                    hierarchy;
+    std::vector<TransformHierarchy::View> views;
+    std::vector<Transform>                transforms;
+    transforms.reserve(COUNT);
+    for (int i = 0; i < COUNT; i++) {
+        auto props  = randomProperties();
+        auto parent = i == 0 ? -1 : glm::linearRand(-1, i - 1);
+        if (parent == -1) {
+            views.push_back(hierarchy.create(props));
+            transforms.emplace_back(Transform::Builder()
+                                        .withPosition(props.translation)
+                                        .withRotation(props.rotation)
+                                        .withScale(props.scale)
+                                        .withSkew(props.skew));
+        } else {
+            views.push_back(hierarchy.create(views[parent], props));
+            transforms.emplace_back(Transform::Builder()
+                                        .withParent(transforms[parent])
+                                        .withPosition(props.translation)
+                                        .withRotation(props.rotation)
+                                        .withScale(props.scale)
+                                        .withSkew(props.skew));
+        }
+    }
+    REQUIRE(hierarchy.size() == COUNT);
+    SUBCASE("WorldMatrices") {
+        auto &worlds = hierarchy.worldMatrices();
+        auto &order  = hierarchy.order();
+        for (std::size_t i = 0; i < worlds.size(); i++) {
+            CHECK_MAT4_EQ(worlds[i], transforms[order[i]].localToWorldMatrix());
+        }
+    }
+    SUBCASE("ViewGetters") {
+        for (int i = 0; i < COUNT; i++) {
+            CHECK_MAT4_EQ(views[i].localToWorldMatrix(), transforms[i].localToWorldMatrix());
+            CHECK_VEC3_EQ(views[i].position(), transforms[i].position());
+            CHECK_VEC3_EQ(views[i].scale(), transforms[i].scale());
+        }
+    }
+    SUBCASE("LocalSetters") {
+        hierarchy.updateWorldMatrices();
+        for (int i = 0; i < COUNT; i += 7) {
+            auto props = randomProperties();
+            views[i].setLocalPosition(props.translation).setLocalRotation(props.rotation);
+            transforms[i].setLocalPosition(props.translation).setLocalRotation(props.rotation);
+        }
+        // Read through the views before and after the update pass.
+        for (int i = 0; i < COUNT; i++) {
+            CHECK_MAT4_EQ(views[i].localToWorldMatrix(), transforms[i].localToWorldMatrix());
+        }
+        hierarchy.updateWorldMatrices();
+        for (int i = 0; i < COUNT; i++) {
+            CHECK_MAT4_EQ(views[i].localToWorldMatrix(), transforms[i].localToWorldMatrix());
+        }
+    }
+    SUBCASE("WorldSetters") {
+        for (int i = 0; i < COUNT; i += 5) {
+            auto pos = glm::linearRand(glm::dvec3{-10, -10, -10}, glm::dvec3{10, 10, 10});
+            views[i].setPosition(pos);
+            transforms[i].setPosition(pos);
+            CHECK_VEC3_EQ(views[i].position(), pos);
+        }
+        for (int i = 0; i < COUNT; i++) {
+            CHECK_VEC3_EQ(views[i].localPosition(), transforms[i].localPosition());
+        }
+    }
+}
+
+TEST_CASE("ReparentResorts") {
+    TransformHierarchy hierarchy;
+    auto               a = hierarchy.create(randomProperties());
+    auto               b = hierarchy.create(a, randomProperties());
+    auto               c = hierarchy.create(randomProperties());
+    auto               d = hierarchy.create(c, randomProperties());
+
+    auto bWorld = b.localToWorldMatrix();
+    // b is stored before d, so making d its parent forces the arrays to be reordered.
+    b.setParent(d);
+    CHECK(b.parent() == d);
+    CHECK_MAT4_EQ(b.localToWorldMatrix(), bWorld);
+
+    auto &order = hierarchy.order();
+    auto  pos   = [&](TransformHierarchy::View v) {
+        return std::find(order.begin(), order.end(), v.id()) - order.begin();
+    };
+    CHECK(pos(c) < pos(d));
+    CHECK(pos(d) < pos(b));
+    auto &worlds = hierarchy.worldMatrices();
+    CHECK_MAT4_EQ(worlds[pos(b)], bWorld);
+    CHECK_MAT4_EQ(worlds[pos(a)], a.localToWorldMatrix());
+}
+
+TEST_CASE("HierarchyParentCycle") {
+    TransformHierarchy hierarchy;
+    auto               t1 = hierarchy.create();
+    SUBCASE("OneLevel") {
+        CHECK_THROWS_AS(t1.setParent(t1), std::invalid_argument);
+    }
+    auto t2 = hierarchy.create(t1);
+    SUBCASE("TwoLevels") {
+        CHECK_THROWS_AS(t1.setParent(t2), std::invalid_argument);
+    }
+    auto t3 = hierarchy.create(t2);
+    SUBCASE("ThreeLevels") {
+        CHECK_THROWS_AS(t1.setParent(t3), std::invalid_argument);
+    }
+}
+
+TEST_CASE("DestroyKeepsChildrenInWorldSpace") {
+    TransformHierarchy hierarchy;
+    auto               parent     = hierarchy.create(randomProperties());
+    auto               child      = hierarchy.create(parent, randomProperties());
+    auto               grandChild = hierarchy.create(child, randomProperties());
+    auto               childMat   = child.localToWorldMatrix();
+    auto               grandMat   = grandChild.localToWorldMatrix();
+    auto               parentId   = parent.id();
+
+    hierarchy.destroy(parent);
+    CHECK_FALSE(hierarchy.contains(parentId));
+    CHECK_FALSE(parent);
+    CHECK_THROWS_AS(hierarchy.get(parentId), std::out_of_range);
+    CHECK(hierarchy.size() == 2);
+    CHECK_FALSE(child.parent());
+    CHECK(grandChild.parent() == child);
+    CHECK_MAT4_EQ(child.localToWorldMatrix(), childMat);
+    CHECK_MAT4_EQ(grandChild.localToWorldMatrix(), grandMat);
+
+    // Freed IDs are recycled by later nodes.
+    auto reused = hierarchy.create(child);
+    CHECK(reused.id() == parentId);
+    CHECK(reused.parent() == child);
+}
+
+TEST_CASE("Clear") {
+    TransformHierarchy hierarchy;
+    auto               root  = hierarchy.create(randomProperties());
+    auto               child = hierarchy.create(root, randomProperties());
+    hierarchy.clear();
+    CHECK(hierarchy.size() == 0);
+    CHECK_FALSE(root);
+    CHECK_FALSE(child);
+    CHECK(hierarchy.worldMatrices().empty());
+
+    auto node = hierarchy.create(randomProperties());
+    CHECK(hierarchy.size() == 1);
+    CHECK_MAT4_EQ(node.localToWorldMatrix(), hierarchy.worldMatrices()[0]);
+}
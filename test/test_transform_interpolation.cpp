@@ -0,0 +1,57 @@
+//
+// Created by taylor-santos on 10/17/2026 at 10:40.
+//
+
+#include "transform_interpolation.h"
+#include "test_helpers.h"
+#include "doctest/doctest.h"
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+TEST_SUITE_BEGIN("TransformInterpolation");
+
+TEST_CASE("Interpolate") {
+    Transform root;
+    Transform child = Transform::Builder().withParent(root).withPosition({1, 0, 0});
+    std::array<const Transform *, 2> transforms{&root, &child};
+    TransformInterpolation           interpolation;
+    std::vector<glm::dmat4>          out(2);
+
+    // With a single capture, every blend is the captured state.
+    interpolation.capture(transforms);
+    interpolation.interpolate(0.5, out);
+    CHECK_MAT4_EQ(out[1], child.localToWorldMatrix());
+
+    root.setLocalRotation(glm::angleAxis(glm::half_pi<double>(), glm::dvec3{0, 0, 1}));
+    root.setLocalPosition({2, 0, 0});
+    interpolation.capture(transforms);
+    interpolation.interpolate(1, out);
+    CHECK_MAT4_EQ(out[0], root.localToWorldMatrix());
+    CHECK_MAT4_EQ(out[1], child.localToWorldMatrix());
+
+    // Halfway, the root has turned by 45 degrees and moved by half as far.
+    interpolation.interpolate(0.5, out);
+    Transform halfway = Transform::Builder()
+                            .withPosition({1, 0, 0})
+                            .withRotation(glm::angleAxis(
+                                glm::quarter_pi<double>(),
+                                glm::dvec3{0, 0, 1}));
+    CHECK_MAT4_EQ(out[0], halfway.localToWorldMatrix());
+
+    std::vector<glm::dmat4> wrongSize(3);
+    CHECK_THROWS_AS(interpolation.interpolate(0.5, wrongSize), std::invalid_argument);
+}
+
+TEST_CASE("ResizeResetsPrevious") {
+    Transform               a;
+    Transform               b = Transform::Builder().withPosition({1, 2, 3});
+    TransformInterpolation  interpolation;
+    std::vector<glm::dmat4> out(2);
+    interpolation.capture(std::array<const Transform *, 1>{&a});
+    interpolation.capture(std::array<const Transform *, 2>{&a, &b});
+    CHECK(interpolation.size() == 2);
+    interpolation.interpolate(0, out);
+    CHECK_MAT4_EQ(out[1], b.localToWorldMatrix());
+}
@@ -0,0 +1,123 @@
+//
+// Created by taylor-santos on 10/17/2026 at 01:20.
+//
+
+#include "transform_journal.h"
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+TEST_SUITE_BEGIN("TransformJournal");
+
+// Flush the journal, sorting the IDs so they can be compared regardless of order.
+static std::vector<TransformJournal::Id>
+flushSorted(TransformJournal &journal) {
+    auto                              ids = journal.flush();
+    std::vector<TransformJournal::Id> sorted(ids.begin(), ids.end());
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+using Ids = std::vector<TransformJournal::Id>;
+
+TEST_CASE("TrackAndFlush") {
+    TransformJournal journal;
+    Transform        a;
+    Transform        b = Transform::Builder().withParent(a);
+    Transform        c;
+    journal.track(a, 0);
+    journal.track(b, 1);
+    journal.track(c, 2);
+    CHECK(journal.size() == 3);
+    CHECK_THROWS_AS(journal.track(a, 3), std::invalid_argument);
+
+    // Newly tracked Transforms are reported once, and then only when they change.
+    CHECK(flushSorted(journal) == Ids{0, 1, 2});
+    CHECK(journal.flush().empty());
+
+    c.setLocalPosition({1, 0, 0});
+    c.setLocalScale({2, 2, 2});
+    CHECK(flushSorted(journal) == Ids{2});
+}
+
+TEST_CASE("DescendantsAreReported") {
+    TransformJournal journal;
+    Transform        root;
+    Transform        middle = Transform::Builder().withParent(root);
+    Transform        leaf   = Transform::Builder().withParent(middle);
+    Transform        other;
+    journal.track(root);
+    journal.track(leaf, 7);
+    journal.track(other, 8);
+    (void)journal.flush();
+
+    // The untracked Transform in between must not hide the leaf.
+    root.setLocalPosition({1, 0, 0});
+    CHECK(flushSorted(journal) == Ids{7});
+
+    // Changing both a Transform and its descendant still reports it once.
+    root.setLocalRotation(glm::angleAxis(1.0, glm::dvec3{0, 1, 0}));
+    leaf.setLocalScale({2, 2, 2});
+    other.setParent(&leaf);
+    CHECK(flushSorted(journal) == Ids{7, 8});
+}
+
+TEST_CASE("Untrack") {
+    TransformJournal journal;
+    Transform        a;
+    journal.track(a, 0);
+    {
+        Transform b;
+        journal.track(b, 1);
+        b.setLocalPosition({1, 0, 0});
+    }
+    // Destroying a tracked Transform discards its pending change.
+    CHECK(journal.size() == 1);
+    CHECK(flushSorted(journal) == Ids{0});
+
+    a.setLocalPosition({1, 0, 0});
+    journal.untrack(a);
+    CHECK(journal.flush().empty());
+    CHECK_THROWS_AS(journal.untrack(a), std::invalid_argument);
+
+    // Its slot can be reused by the same Transform under a new ID.
+    journal.track(a, 2);
+    CHECK(flushSorted(journal) == Ids{2});
+}
+
+TEST_CASE("TrackingFollowsMoves") {
+    TransformJournal journal;
+    Transform        a;
+    journal.track(a, 0);
+    (void)journal.flush();
+
+    Transform b = std::move(a);
+    b.setLocalPosition({1, 0, 0});
+    CHECK(flushSorted(journal) == Ids{0});
+    a.setLocalPosition({1, 0, 0});
+    CHECK(journal.flush().empty());
+
+    // A copy is not tracked, and copying into a tracked Transform keeps it tracked.
+    Transform c = b;
+    c.setLocalPosition({2, 0, 0});
+    CHECK(journal.flush().empty());
+    b = c;
+    CHECK(flushSorted(journal) == Ids{0});
+    CHECK(b.localPosition().x == doctest::Approx(2));
+}
+
+TEST_CASE("JournalOutlivedByTransforms") {
+    Transform a;
+    {
+        TransformJournal journal;
+        journal.track(a, 0);
+    }
+    // Setters must not touch the destroyed journal.
+    a.setLocalPosition({1, 0, 0});
+    TransformJournal journal;
+    journal.track(a, 1);
+    CHECK(flushSorted(journal) == Ids{1});
+}
@@ -0,0 +1,175 @@
+//
+// Created by taylor-santos on 10/16/2026 at 23:58.
+//
+
+#include "transform_pool.h"
+#include "transform_bake.h"
+#include "doctest/doctest.h"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+TEST_SUITE_BEGIN("TransformPool");
+
+TEST_CASE("CreateAndGet") {
+    TransformPool pool;
+    auto          root  = pool.create(Transform::Builder().withPosition({1, 2, 3}));
+    auto          child = pool.create(Transform::Builder().withParent(pool.get(root)));
+    CHECK(pool.size() == 2);
+    CHECK(pool.contains(root));
+    CHECK(pool.contains(child));
+    CHECK(root != child);
+    CHECK(pool.get(root).position() == glm::dvec3{1, 2, 3});
+    CHECK(pool.get(child).parent() == &pool.get(root));
+    CHECK(pool.find(TransformPool::Handle{}) == nullptr);
+    CHECK_THROWS_AS((void)pool.get(TransformPool::Handle{}), std::out_of_range);
+}
+
+TEST_CASE("StaleHandles") {
+    TransformPool pool;
+    auto          first = pool.create();
+    pool.destroy(first);
+    CHECK_FALSE(pool.contains(first));
+    CHECK(pool.find(first) == nullptr);
+    CHECK_THROWS_AS((void)pool.get(first), std::out_of_range);
+    CHECK_THROWS_AS(pool.destroy(first), std::out_of_range);
+
+    // The slot is reused, but the old Handle must not refer to its new occupant.
+    auto second = pool.create();
+    CHECK(second != first);
+    CHECK_FALSE(pool.contains(first));
+    CHECK(pool.size() == 1);
+}
+
+TEST_CASE("StableAddresses") {
+    TransformPool pool;
+    auto          root     = pool.create();
+    auto         *rootAddr = &pool.get(root);
+    auto          child    = pool.create(Transform::Builder().withParent(*rootAddr));
+    auto         *childPtr = &pool.get(child);
+    // Grow well past the first chunk.
+    for (std::size_t i = 0; i < 4 * TransformPool::CHUNK_SIZE; i++) {
+        (void)pool.create(Transform::Builder().withParent(*rootAddr));
+    }
+    CHECK(&pool.get(root) == rootAddr);
+    CHECK(&pool.get(child) == childPtr);
+    CHECK(childPtr->parent() == rootAddr);
+
+    SUBCASE("Move") {
+        TransformPool moved = std::move(pool);
+        CHECK(&moved.get(root) == rootAddr);
+        CHECK(moved.get(child).parent() == rootAddr);
+        CHECK(moved.size() == 4 * TransformPool::CHUNK_SIZE + 2);
+    }
+    SUBCASE("DestroyParent") {
+        rootAddr->setLocalPosition({1, 0, 0});
+        pool.destroy(root);
+        CHECK(childPtr->parent() == nullptr);
+        // Like ~Transform(), children must keep their world-space position.
+        CHECK(childPtr->position().x == doctest::Approx(1));
+    }
+}
+
+TEST_CASE("Compact") {
+    TransformPool                      pool;
+    std::vector<TransformPool::Handle> handles;
+    for (std::size_t i = 0; i < 3 * TransformPool::CHUNK_SIZE; i++) {
+        handles.push_back(pool.create());
+    }
+    auto  first      = handles.front();
+    auto *firstAddr  = &pool.get(first);
+    auto *secondAddr = &pool.get(handles[1]);
+    for (std::size_t i = 1; i < handles.size(); i++) {
+        pool.destroy(handles[i]);
+    }
+    pool.compact();
+    CHECK(pool.capacity() == TransformPool::CHUNK_SIZE);
+    CHECK(&pool.get(first) == firstAddr);
+    for (std::size_t i = 1; i < handles.size(); i++) {
+        CHECK_FALSE(pool.contains(handles[i]));
+    }
+
+    // New Transforms fill the lowest free slots first.
+    auto next = pool.create();
+    CHECK(&pool.get(next) == secondAddr);
+
+    // Reallocating a released chunk must not revive Handles into it.
+    for (std::size_t i = 0; i < 2 * TransformPool::CHUNK_SIZE; i++) {
+        (void)pool.create();
+    }
+    CHECK(pool.capacity() == 3 * TransformPool::CHUNK_SIZE);
+    for (std::size_t i = 1; i < handles.size(); i++) {
+        CHECK_FALSE(pool.contains(handles[i]));
+    }
+}
+
+TEST_CASE("SinglePrecisionPool") {
+    TransformPoolF pool;
+    auto           handle = pool.create(TransformF::Builder().withScale({2, 2, 2}));
+    CHECK(pool.get(handle).scale() == glm::vec3{2, 2, 2});
+}
+
+TEST_CASE("DestroySubtree") {
+    TransformPool pool;
+    auto          root    = pool.create(Transform::Builder().withPosition({1, 0, 0}));
+    auto          sibling = pool.create();
+
+    std::vector<TransformPool::Handle> subtree{root};
+    for (std::size_t i = 1; i < 2 * TransformPool::CHUNK_SIZE; i++) {
+        auto &parent = pool.get(subtree[(i - 1) / 2]);
+        subtree.push_back(pool.create(Transform::Builder().withParent(parent)));
+    }
+    auto &siblingChild = pool.get(pool.create(Transform::Builder().withParent(pool.get(sibling))));
+    // A Transform outside the pool beneath the subtree must survive it.
+    Transform outsider =
+        Transform::Builder().withPosition({0, 2, 0}).withParent(pool.get(subtree[7]));
+
+    pool.destroySubtree(root);
+    for (auto handle : subtree) {
+        CHECK_FALSE(pool.contains(handle));
+    }
+    CHECK(pool.size() == 2);
+    CHECK(siblingChild.parent() == &pool.get(sibling));
+    CHECK(outsider.parent() == nullptr);
+    CHECK(outsider.position().x == doctest::Approx(1));
+    CHECK(outsider.position().y == doctest::Approx(2));
+    CHECK_THROWS_AS(pool.destroySubtree(root), std::out_of_range);
+}
+
+TEST_CASE("ClearKeepsOutsidersInPlace") {
+    // A Transform outside the pool, beneath a pooled Transform that isn't a root.
+    Transform outsider;
+    {
+        TransformPool pool;
+        auto          root  = pool.create(Transform::Builder().withPosition({10, 0, 0}));
+        auto          child = pool.create(
+            Transform::Builder().withPosition({5, 0, 0}).withParent(pool.get(root)));
+        outsider.setParent(&pool.get(child), true);
+        outsider.setLocalPosition({1, 0, 0});
+        CHECK(outsider.position().x == doctest::Approx(16));
+    }
+    CHECK(outsider.parent() == nullptr);
+    CHECK(outsider.position().x == doctest::Approx(16));
+}
+
+TEST_CASE("ClearFrozen") {
+    // A baked hierarchy of pooled Transforms, ending in a frozen Transform outside the pool.
+    Transform     outsider;
+    TransformBake baked;
+    {
+        TransformPool pool;
+        auto          root  = pool.create(Transform::Builder().withPosition({10, 0, 0}));
+        auto          child = pool.create(
+            Transform::Builder().withPosition({5, 0, 0}).withParent(pool.get(root)));
+        outsider.setParent(&pool.get(child), true);
+        outsider.setLocalPosition({1, 0, 0});
+        baked = pool.get(root).bake();
+        REQUIRE(baked.size() == 3);
+    }
+    REQUIRE(baked.size() == 1);
+    CHECK(baked.transforms()[0] == &outsider);
+    CHECK(outsider.frozen());
+    CHECK(outsider.parent() == nullptr);
+    CHECK(outsider.position().x == doctest::Approx(16));
+}
@@ -0,0 +1,107 @@
+//
+// Created by taylor-santos on 10/17/2026 at 09:40.
+//
+
+#include "transform_prefab.h"
+#include "test_helpers.h"
+#include "doctest/doctest.h"
+
+#include <array>
+#include <numbers>
+#include <stdexcept>
+
+#include "glm/gtc/matrix_transform.hpp"
+
+TEST_SUITE_BEGIN("TransformPrefab");
+
+namespace {
+
+constexpr double HALF_PI = std::numbers::pi / 2;
+
+// A table with a pedestal and a rotated, scaled vase on top, flattened during compilation.
+constexpr std::array<Prefab::Node<double>, 3> VASE{{
+    {Prefab::none, {.translation = {10, 0, 0}}},
+    {0, {.translation = {0, 1, 0}, .rotation = Prefab::angleAxis(HALF_PI, {0, 1, 0})}},
+    {1, {.translation = {0, 0, 2}, .scale = {2, 2, 2}, .skew = {0.5, 0, 0}}},
+}};
+constexpr auto VASE_WORLDS = Prefab::flatten(VASE);
+
+constexpr bool
+approxEqual(double a, double b) {
+    return a - b < 1e-9 && b - a < 1e-9;
+}
+
+// The vase's origin is two units along the pedestal's z axis, which the rotation turns onto x.
+static_assert(approxEqual(VASE_WORLDS[2].m[3][0], 12));
+static_assert(approxEqual(VASE_WORLDS[2].m[3][1], 1));
+static_assert(approxEqual(VASE_WORLDS[2].m[3][2], 0));
+static_assert(approxEqual(Prefab::sqrt(2.0) * Prefab::sqrt(2.0), 2));
+static_assert(approxEqual(Prefab::sin(HALF_PI), 1) && approxEqual(Prefab::cos(3 * HALF_PI), 0));
+
+// Build the same hierarchy as VASE out of Transforms.
+void
+buildVase(std::array<Transform, 3> &nodes) {
+    for (std::size_t i = 0; i < VASE.size(); i++) {
+        nodes[i] = Transform::Builder()
+                       .withPosition(Prefab::toGlm(VASE[i].locals.translation))
+                       .withRotation(Prefab::toGlm(VASE[i].locals.rotation))
+                       .withScale(Prefab::toGlm(VASE[i].locals.scale))
+                       .withSkew(Prefab::toGlm(VASE[i].locals.skew));
+        if (VASE[i].parent != Prefab::none) {
+            nodes[i].setParent(&nodes[VASE[i].parent], true);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("FlattenMatchesTransforms") {
+    std::array<Transform, 3> nodes;
+    buildVase(nodes);
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        CHECK_MAT4_EQ(Prefab::toGlm(VASE_WORLDS[i]), nodes[i].localToWorldMatrix());
+    }
+}
+
+TEST_CASE("RecomposeMatchesTransform") {
+    auto props = Prefab::toGlm(VASE[2].locals);
+    // Evaluated at compile time, to check the constexpr paths against glm's.
+    constexpr auto matrix  = Prefab::recompose(VASE[2].locals);
+    constexpr auto inverse = Prefab::recomposeInverse(VASE[2].locals);
+    glm::dmat4     skew{1};
+    skew[1][0] = props.skew.x;
+    skew[2][0] = props.skew.y;
+    skew[2][1] = props.skew.z;
+    auto expected = glm::translate(glm::dmat4{1}, props.translation) * glm::toMat4(props.rotation) *
+                    glm::scale(glm::dmat4{1}, props.scale) * skew;
+    CHECK_MAT4_EQ(Prefab::toGlm(matrix), expected);
+    CHECK_MAT4_EQ(Transform::recompose(props), expected);
+    CHECK_MAT4_EQ(Prefab::toGlm(inverse), glm::inverse(expected));
+    CHECK_MAT4_EQ(Transform::recomposeInverse(props), glm::inverse(expected));
+    CHECK_MAT4_EQ(Prefab::toGlm(Prefab::affineInverse(matrix)), Prefab::toGlm(inverse));
+    CHECK_MAT4_EQ(Prefab::toGlm(matrix * inverse), glm::dmat4(1));
+}
+
+TEST_CASE("QuaternionRoundTrip") {
+    constexpr auto q = Prefab::normalize(Prefab::Quat<double>{0.3, -0.5, 0.7, 0.1});
+    constexpr auto r = Prefab::toQuat(Prefab::toMat3(q));
+    // q and -q are the same rotation.
+    double sign = q.w * r.w < 0 ? -1 : 1;
+    CHECK(r.w * sign == doctest::Approx(q.w));
+    CHECK(r.x * sign == doctest::Approx(q.x));
+    CHECK(r.y * sign == doctest::Approx(q.y));
+    CHECK(r.z * sign == doctest::Approx(q.z));
+    auto glmRotation = glm::toMat3(Prefab::toGlm(q));
+    auto rotation    = Prefab::toGlm(Prefab::toMat3(q * Prefab::conjugate(q)));
+    for (int c = 0; c < 3; c++) {
+        for (int row = 0; row < 3; row++) {
+            CHECK(rotation[c][row] == doctest::Approx(c == row ? 1 : 0));
+            CHECK(Prefab::toMat3(q).m[c][row] == doctest::Approx(glmRotation[c][row]));
+        }
+    }
+}
+
+TEST_CASE("FlattenRejectsLaterParents") {
+    std::array<Prefab::Node<double>, 2> nodes{{{1, {}}, {Prefab::none, {}}}};
+    CHECK_THROWS_AS((void)Prefab::flatten(nodes), std::invalid_argument);
+}
@@ -0,0 +1,81 @@
+//
+// Created by taylor-santos on 10/17/2026 at 03:24.
+//
+
+#include "transform_snapshot.h"
+#include "doctest/doctest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_SUITE_BEGIN("TransformSnapshots");
+
+TEST_CASE("PublishAndAcquire") {
+    TransformSnapshots snapshots;
+    CHECK(snapshots.acquire().sequence == 0);
+    CHECK(snapshots.acquire().matrices.empty());
+
+    Transform root  = Transform::Builder().withPosition({1, 0, 0});
+    Transform child = Transform::Builder().withParent(root).withPosition({0, 2, 0});
+    snapshots.publish(root);
+    auto &first = snapshots.acquire();
+    CHECK(first.sequence == 1);
+    REQUIRE(first.matrices.size() == 2);
+    CHECK(first.matrices[0] == root.localToWorldMatrix());
+    CHECK(first.matrices[1] == child.localToWorldMatrix());
+
+    // Later changes don't reach an acquired snapshot.
+    root.setLocalPosition({5, 0, 0});
+    const Transform *transforms[] = {&child};
+    snapshots.publish(transforms);
+    CHECK(first.matrices[0][3].x == 1);
+
+    // Only the latest of several publishes is seen, and it is kept until the next one.
+    root.setLocalPosition({6, 0, 0});
+    snapshots.publish(transforms);
+    auto &latest = snapshots.acquire();
+    CHECK(latest.sequence == 3);
+    REQUIRE(latest.matrices.size() == 1);
+    CHECK(latest.matrices[0] == child.localToWorldMatrix());
+    CHECK(&snapshots.acquire() == &latest);
+}
+
+TEST_CASE("ConcurrentReader") {
+    constexpr int      ticks = 2000;
+    TransformSnapshots snapshots;
+    std::atomic<bool>  done{false};
+    // Checked on the main thread once the reader has finished.
+    std::atomic<bool> ordered{true};
+    std::atomic<bool> consistent{true};
+
+    std::thread reader([&] {
+        std::uint64_t last = 0;
+        while (!done.load()) {
+            auto &snapshot = snapshots.acquire();
+            if (snapshot.sequence < last) ordered = false;
+            last = snapshot.sequence;
+            // Every matrix in a snapshot must come from the same tick.
+            for (auto &matrix : snapshot.matrices) {
+                if (matrix[3].x != snapshot.matrices[0][3].x) consistent = false;
+            }
+        }
+    });
+
+    std::vector<Transform> transforms(64);
+    for (int tick = 1; tick <= ticks; tick++) {
+        std::vector<const Transform *> pointers;
+        for (auto &transform : transforms) {
+            transform.setLocalPosition({tick, 0, 0});
+            pointers.push_back(&transform);
+        }
+        snapshots.publish(pointers);
+    }
+    done = true;
+    reader.join();
+    CHECK(ordered);
+    CHECK(consistent);
+    auto &last = snapshots.acquire();
+    CHECK(last.sequence == ticks);
+    CHECK(last.matrices[0][3].x == ticks);
+}